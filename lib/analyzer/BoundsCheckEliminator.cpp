@@ -0,0 +1,505 @@
+/*
+ * Analysis pass that removes redundant array bounds checks in the Oberon LLVM compiler.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#include "BoundsCheckEliminator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "data/symtab/SymbolTable.h"
+#include "system/PredefinedProcedure.h"
+
+using std::string;
+using std::to_string;
+
+// Constants beyond this limit are not considered, so that the offsets of bounds and indices cannot overflow.
+static constexpr int64_t OFFSET_LIMIT = INT32_MAX;
+
+void BoundsCheckEliminator::run(Logger &logger, Node *node) {
+    if (logger.getErrorCount() == 0 && config_.isSanitized(Trap::OUT_OF_BOUNDS)) {
+        logger_ = &logger;
+        node->accept(*this);
+    }
+}
+
+optional<BoundsCheckEliminator::Bound> BoundsCheckEliminator::bound(ExpressionNode *expr) {
+    if (const auto literal = dynamic_cast<IntegerLiteralNode *>(expr)) {
+        if (std::abs(literal->value()) > OFFSET_LIMIT) {
+            return std::nullopt;
+        }
+        return Bound{nullptr, 0, literal->value()};
+    }
+    if (const auto binary = dynamic_cast<BinaryExpressionNode *>(expr)) {
+        const auto op = binary->getOperator();
+        if (op != OperatorType::PLUS && op != OperatorType::MINUS) {
+            return std::nullopt;
+        }
+        auto lhs = bound(binary->getLeftExpression());
+        auto rhs = bound(binary->getRightExpression());
+        if (!lhs || !rhs || (lhs->array && rhs->array) || (rhs->array && op == OperatorType::MINUS)) {
+            return std::nullopt;
+        }
+        const auto offset = op == OperatorType::PLUS ? lhs->offset + rhs->offset : lhs->offset - rhs->offset;
+        if (std::abs(offset) > OFFSET_LIMIT) {
+            return std::nullopt;
+        }
+        return lhs->array ? Bound{lhs->array, lhs->dimension, offset} : Bound{rhs->array, rhs->dimension, offset};
+    }
+    // LEN(a) or LEN(a, dim) of an array that is not modified, as it is referenced without selectors
+    const auto qual = dynamic_cast<QualifiedExpression *>(expr);
+    if (!qual || qual->selectors().size() != 1 || qual->selectors()[0]->getNodeType() != NodeType::parameter) {
+        return std::nullopt;
+    }
+    const auto proc = dynamic_cast<PredefinedProcedure *>(qual->dereference());
+    if (!proc || proc->getKind() != ProcKind::LEN) {
+        return std::nullopt;
+    }
+    auto &params = dynamic_cast<ActualParameters *>(qual->selectors()[0].get())->parameters();
+    if (params.empty() || params.size() > 2) {
+        return std::nullopt;
+    }
+    const auto array = dynamic_cast<QualifiedExpression *>(params[0].get());
+    if (!array || !array->selectors().empty()) {
+        return std::nullopt;
+    }
+    const auto type = dynamic_cast<ArrayTypeNode *>(array->getType());
+    int64_t dim = 0;
+    if (params.size() == 2) {
+        const auto literal = dynamic_cast<IntegerLiteralNode *>(params[1].get());
+        if (!literal) {
+            return std::nullopt;
+        }
+        dim = literal->value();
+    }
+    if (!type || dim < 0 || dim >= type->dimensions()) {
+        return std::nullopt;
+    }
+    const auto dimension = static_cast<uint32_t>(dim);
+    if (type->isOpen()) {
+        const auto decl = array->dereference();
+        if (!decl || decl->getNodeType() != NodeType::parameter) {
+            return std::nullopt;
+        }
+        return Bound{decl, dimension, 0};
+    }
+    return Bound{nullptr, 0, static_cast<int64_t>(type->lengths()[dimension])};
+}
+
+optional<pair<QualifiedExpression *, int64_t>> BoundsCheckEliminator::affine(ExpressionNode *expr) {
+    if (const auto literal = dynamic_cast<IntegerLiteralNode *>(expr)) {
+        if (std::abs(literal->value()) > OFFSET_LIMIT) {
+            return std::nullopt;
+        }
+        return pair<QualifiedExpression *, int64_t>{nullptr, literal->value()};
+    }
+    if (const auto qual = dynamic_cast<QualifiedExpression *>(expr)) {
+        // only signed integers, as the index of an array access is sign-extended
+        if (qual->selectors().empty() && isLocal(qual->dereference()) && qual->getType()->isInteger()) {
+            return pair<QualifiedExpression *, int64_t>{qual, 0};
+        }
+        return std::nullopt;
+    }
+    if (const auto binary = dynamic_cast<BinaryExpressionNode *>(expr)) {
+        const auto op = binary->getOperator();
+        if (op != OperatorType::PLUS && op != OperatorType::MINUS) {
+            return std::nullopt;
+        }
+        auto lhs = affine(binary->getLeftExpression());
+        auto rhs = affine(binary->getRightExpression());
+        if (!lhs || !rhs || (lhs->first && rhs->first) || (rhs->first && op == OperatorType::MINUS)) {
+            return std::nullopt;
+        }
+        const auto offset = op == OperatorType::PLUS ? lhs->second + rhs->second : lhs->second - rhs->second;
+        if (std::abs(offset) > OFFSET_LIMIT) {
+            return std::nullopt;
+        }
+        return pair<QualifiedExpression *, int64_t>{lhs->first ? lhs->first : rhs->first, offset};
+    }
+    return std::nullopt;
+}
+
+bool BoundsCheckEliminator::isLocal(const DeclarationNode *decl) {
+    // Local variables and value parameters can only be modified by the procedure itself or by passing them as
+    // variable parameters, as the variables of procedures with nested procedures are moved to their environment
+    if (!decl || decl->getScope() <= SymbolTable::MODULE_SCOPE) {
+        return false;
+    }
+    if (decl->getNodeType() == NodeType::parameter) {
+        return !dynamic_cast<const ParameterNode *>(decl)->isVar();
+    }
+    return decl->getNodeType() == NodeType::variable;
+}
+
+bool BoundsCheckEliminator::isInvariant(ExpressionNode *expr, const set<DeclarationNode *> &modified) {
+    if (expr->isLiteral()) {
+        return true;
+    }
+    if (const auto unary = dynamic_cast<UnaryExpressionNode *>(expr)) {
+        return isInvariant(unary->getExpression(), modified);
+    }
+    if (const auto binary = dynamic_cast<BinaryExpressionNode *>(expr)) {
+        return isInvariant(binary->getLeftExpression(), modified) &&
+               isInvariant(binary->getRightExpression(), modified);
+    }
+    if (const auto qual = dynamic_cast<QualifiedExpression *>(expr)) {
+        const auto decl = qual->dereference();
+        if (qual->selectors().empty()) {
+            return (isLocal(decl) && !modified.contains(decl)) ||
+                   (decl && decl->getNodeType() == NodeType::constant);
+        }
+        return bound(expr).has_value();
+    }
+    return false;
+}
+
+bool BoundsCheckEliminator::isVarArgument(DeclarationNode *decl, ProcedureTypeNode *type, const size_t num) {
+    if (const auto proc = dynamic_cast<PredefinedProcedure *>(decl)) {
+        switch (proc->getKind()) {
+            case ProcKind::ABS: case ProcKind::ASH: case ProcKind::ASR: case ProcKind::ASSERT:
+            case ProcKind::CAP: case ProcKind::CHR: case ProcKind::ENTIER: case ProcKind::FLOOR:
+            case ProcKind::FLT: case ProcKind::HALT: case ProcKind::LEN: case ProcKind::LONG:
+            case ProcKind::LSL: case ProcKind::MAX: case ProcKind::MIN: case ProcKind::ODD:
+            case ProcKind::ORD: case ProcKind::ROR: case ProcKind::SHORT: case ProcKind::SIZE:
+            case ProcKind::SYSTEM_SIZE: case ProcKind::SYSTEM_BIT: case ProcKind::SYSTEM_VAL:
+            case ProcKind::SYSTEM_PUT: case ProcKind::SYSTEM_COPY:
+                return false;
+            default:
+                // INC, DEC, NEW, etc. modify their arguments, ADR makes them accessible through their address
+                return true;
+        }
+    }
+    if (!type) {
+        return true;
+    }
+    // Variadic arguments are passed by value
+    return num < type->parameters().size() && type->parameters()[num]->isVar();
+}
+
+bool BoundsCheckEliminator::isInBounds(const Bound &lower, const Bound &upper, const int64_t offset,
+                                       const Bound &length) {
+    // The length of an array is never negative, so the lower bound is in bounds if its offset is.
+    if (lower.offset + offset < 0) {
+        return false;
+    }
+    // The upper bound is in bounds if it has the same base as the length and a smaller offset.
+    return upper.array == length.array && upper.dimension == length.dimension && upper.offset + offset < length.offset;
+}
+
+void BoundsCheckEliminator::guard(Loop &loop, QualifiedExpression *index, const int64_t offset,
+                                  ArrayTypeNode *array, DeclarationNode *decl, const uint32_t dimension) {
+    const auto var = index ? index->dereference() : nullptr;
+    for (auto &guard : loop.node->guards()) {
+        if ((guard.index ? guard.index->dereference() : nullptr) == var && guard.array == array &&
+            guard.decl == decl && guard.dimension == dimension) {
+            guard.lower = std::min(guard.lower, offset);
+            guard.upper = std::max(guard.upper, offset);
+            return;
+        }
+    }
+    loop.node->guards().push_back({index, offset, offset, array, decl, dimension});
+}
+
+void BoundsCheckEliminator::check(ArrayIndex *array, ArrayTypeNode *type, DeclarationNode *decl) {
+    for (size_t i = 0; i < array->indices().size() && i < type->dimensions(); ++i) {
+        const auto expr = array->indices()[i].get();
+        const auto dimension = static_cast<uint32_t>(i);
+        // Constant indices into arrays of fixed length are not checked at run-time
+        if (!type->isOpen() && expr->isLiteral()) {
+            continue;
+        }
+        // The length of an open array is only known if it is the parameter that is accessed
+        if (type->isOpen() && (!decl || decl->getNodeType() != NodeType::parameter)) {
+            continue;
+        }
+        const auto length = type->isOpen() ? Bound{decl, dimension, 0} :
+                                             Bound{nullptr, 0, static_cast<int64_t>(type->lengths()[i])};
+        const auto index = affine(expr);
+        if (!index) {
+            continue;
+        }
+        const auto [var, offset] = index.value();
+        const auto ref = var ? var->dereference() : nullptr;
+        // The index is the counter of an enclosing loop
+        auto loop = std::find_if(loops_.rbegin(), loops_.rend(), [ref](const Loop &l) {
+            return ref && l.counter == ref;
+        });
+        if (loop != loops_.rend() && loop->valid) {
+            if (loop->min && loop->max && isInBounds(loop->min.value(), loop->max.value(), offset, length)) {
+                array->setCheck(i, BoundsCheck::REDUNDANT);
+                ++loop->removed;
+                continue;
+            }
+            if (loop->invariant) {
+                guard(*loop, var, offset, type, type->isOpen() ? decl : nullptr, dimension);
+                array->setCheck(i, BoundsCheck::GUARDED, loop->node);
+                loop->guarded.emplace_back(array, i);
+                ++loop->hoisted;
+                continue;
+            }
+        }
+        // The index is invariant in the outermost enclosing loop that neither modifies nor counts the variable,
+        // hence also in all loops nested in that loop
+        const auto outer = std::find_if(loops_.begin(), loops_.end(), [ref](const Loop &l) {
+            return l.counter != ref && !l.modified.contains(ref);
+        });
+        if (outer != loops_.end()) {
+            guard(*outer, var, offset, type, type->isOpen() ? decl : nullptr, dimension);
+            array->setCheck(i, BoundsCheck::GUARDED, outer->node);
+            outer->guarded.emplace_back(array, i);
+            ++outer->hoisted;
+        }
+    }
+}
+
+void BoundsCheckEliminator::modifies(ExpressionNode *expr) {
+    if (const auto qual = dynamic_cast<QualifiedExpression *>(expr)) {
+        modified_->insert(qual->dereference());
+    }
+}
+
+void BoundsCheckEliminator::selectors(DeclarationNode *decl, vector<unique_ptr<Selector>> &selectors) {
+    TypeNode *base = decl ? decl->getType() : nullptr;
+    for (size_t i = 0; i < selectors.size(); ++i) {
+        const auto sel = selectors[i].get();
+        if (sel->getNodeType() == NodeType::parameter) {
+            const auto params = dynamic_cast<ActualParameters *>(sel);
+            const auto type = dynamic_cast<ProcedureTypeNode *>(base);
+            for (size_t j = 0; j < params->parameters().size(); ++j) {
+                const auto param = params->parameters()[j].get();
+                param->accept(*this);
+                if (modified_ && isVarArgument(i == 0 ? decl : nullptr, type, j)) {
+                    modifies(param);
+                }
+            }
+            base = type ? type->getReturnType() : nullptr;
+        } else if (sel->getNodeType() == NodeType::array_type) {
+            const auto array = dynamic_cast<ArrayIndex *>(sel);
+            const auto type = dynamic_cast<ArrayTypeNode *>(base);
+            for (const auto &index : array->indices()) {
+                index->accept(*this);
+            }
+            if (!modified_ && type) {
+                check(array, type, i == 0 ? decl : nullptr);
+            }
+            const auto count = array->indices().size();
+            base = type && count > 0 && count <= type->types().size() ? type->types()[count - 1] : nullptr;
+        } else if (sel->getNodeType() == NodeType::pointer_type) {
+            const auto type = dynamic_cast<PointerTypeNode *>(base);
+            base = type ? type->getBase() : nullptr;
+        } else if (sel->getNodeType() == NodeType::record_type) {
+            const auto field = dynamic_cast<RecordField *>(sel)->getField();
+            base = field ? field->getType() : nullptr;
+        } else if (sel->getNodeType() == NodeType::type) {
+            base = dynamic_cast<Typeguard *>(sel)->getType();
+        }
+    }
+}
+
+void BoundsCheckEliminator::visit(ModuleNode &node) {
+    for (size_t i = 0; i < node.getProcedureCount(); i++) {
+        node.getProcedure(i)->accept(*this);
+    }
+    node.statements()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(ProcedureDeclarationNode &) {}
+
+void BoundsCheckEliminator::visit(ProcedureDefinitionNode &node) {
+    for (size_t i = 0; i < node.getProcedureCount(); i++) {
+        node.getProcedure(i)->accept(*this);
+    }
+    node.statements()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(ImportNode &) {}
+
+void BoundsCheckEliminator::visit(ConstantDeclarationNode &) {}
+
+void BoundsCheckEliminator::visit(FieldNode &) {}
+
+void BoundsCheckEliminator::visit(ParameterNode &) {}
+
+void BoundsCheckEliminator::visit(TypeDeclarationNode &) {}
+
+void BoundsCheckEliminator::visit(VariableDeclarationNode &) {}
+
+void BoundsCheckEliminator::visit(QualifiedStatement &node) {
+    selectors(node.dereference(), node.selectors());
+}
+
+void BoundsCheckEliminator::visit(QualifiedExpression &node) {
+    selectors(node.dereference(), node.selectors());
+}
+
+void BoundsCheckEliminator::visit(BooleanLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(IntegerLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(RealLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(StringLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(CharLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(NilLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(SetLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(RangeLiteralNode &) {}
+
+void BoundsCheckEliminator::visit(UnaryExpressionNode &node) {
+    node.getExpression()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(BinaryExpressionNode &node) {
+    node.getLeftExpression()->accept(*this);
+    node.getRightExpression()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(RangeExpressionNode &node) {
+    node.getLower()->accept(*this);
+    node.getUpper()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(SetExpressionNode &node) {
+    for (auto &element : node.elements()) {
+        element->accept(*this);
+    }
+}
+
+void BoundsCheckEliminator::visit(ArrayTypeNode &) {}
+
+void BoundsCheckEliminator::visit(BasicTypeNode &) {}
+
+void BoundsCheckEliminator::visit(ProcedureTypeNode &) {}
+
+void BoundsCheckEliminator::visit(RecordTypeNode &) {}
+
+void BoundsCheckEliminator::visit(PointerTypeNode &) {}
+
+void BoundsCheckEliminator::visit(StatementSequenceNode &node) {
+    for (size_t i = 0; i < node.getStatementCount(); i++) {
+        node.getStatement(i)->accept(*this);
+    }
+}
+
+void BoundsCheckEliminator::visit(AssignmentNode &node) {
+    node.getLvalue()->accept(*this);
+    node.getRvalue()->accept(*this);
+    if (modified_) {
+        modifies(node.getLvalue());
+    }
+}
+
+void BoundsCheckEliminator::visit(CaseOfNode &node) {
+    node.getExpression()->accept(*this);
+    for (size_t i = 0; i < node.getCaseCount(); ++i) {
+        node.getCase(i)->accept(*this);
+    }
+    if (node.hasElse()) {
+        node.getElseStatements()->accept(*this);
+    }
+}
+
+void BoundsCheckEliminator::visit(CaseLabelNode &node) {
+    for (size_t i = 0; i < node.getValueCount(); ++i) {
+        node.getValue(i)->accept(*this);
+    }
+}
+
+void BoundsCheckEliminator::visit(CaseNode &node) {
+    node.getLabel()->accept(*this);
+    node.getStatements()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(IfThenElseNode &node) {
+    node.getCondition()->accept(*this);
+    node.getThenStatements()->accept(*this);
+    for (size_t i = 0; i < node.getElseIfCount(); i++) {
+        node.getElseIf(i)->accept(*this);
+    }
+    if (node.hasElse()) {
+        node.getElseStatements()->accept(*this);
+    }
+}
+
+void BoundsCheckEliminator::visit(ElseIfNode &node) {
+    node.getCondition()->accept(*this);
+    node.getStatements()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(LoopNode &node) {
+    node.getStatements()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(WhileLoopNode &node) {
+    node.getCondition()->accept(*this);
+    node.getStatements()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(RepeatLoopNode &node) {
+    node.getStatements()->accept(*this);
+    node.getCondition()->accept(*this);
+}
+
+void BoundsCheckEliminator::visit(ForLoopNode &node) {
+    node.getLow()->accept(*this);
+    node.getHigh()->accept(*this);
+    const auto counter = node.getCounter()->dereference();
+    if (modified_) {
+        modified_->insert(counter);
+        node.getStatements()->accept(*this);
+        return;
+    }
+    // Collect the variables that are modified by the loop
+    set<DeclarationNode *> modified;
+    modified_ = &modified;
+    node.getStatements()->accept(*this);
+    modified_ = nullptr;
+    Loop loop{&node, counter, false, false, std::nullopt, std::nullopt, std::move(modified), {}, false, 0, 0};
+    if (node.getCounter()->selectors().empty() && isLocal(counter) && !loop.modified.contains(counter)) {
+        // The loop is only entered if the low bound is not beyond the high bound
+        const auto step = dynamic_cast<IntegerLiteralNode *>(node.getStep())->value();
+        const auto low = bound(node.getLow());
+        const auto high = bound(node.getHigh());
+        loop.valid = true;
+        // The high bound is evaluated in every iteration, whereas the low bound is only evaluated once
+        loop.invariant = isInvariant(node.getHigh(), loop.modified);
+        loop.min = step > 0 ? low : high;
+        loop.max = step > 0 ? high : low;
+    }
+    loops_.push_back(std::move(loop));
+    node.getStatements()->accept(*this);
+    auto &current = loops_.back();
+    if (current.nested) {
+        // Only the innermost loop is generated twice, the indices guarded by this loop are checked again
+        for (const auto &[array, index] : current.guarded) {
+            array->setCheck(index, BoundsCheck::REQUIRED);
+        }
+        node.guards().clear();
+        current.hoisted = 0;
+    }
+    const auto versioned = current.nested || !node.guards().empty();
+    const auto removed = current.removed;
+    const auto hoisted = current.hoisted;
+    loops_.pop_back();
+    if (!loops_.empty()) {
+        loops_.back().nested |= versioned;
+    }
+    if (config_.hasRemark(Remark::BOUNDS_CHECK) && (removed > 0 || hoisted > 0)) {
+        logger_->remark(node.pos(), to_string(removed) + " bounds check(s) removed, " + to_string(hoisted) +
+                                    " bounds check(s) hoisted out of loop [-Rpass=bounds-check]");
+    }
+}
+
+void BoundsCheckEliminator::visit(ReturnNode &node) {
+    if (node.getValue()) {
+        node.getValue()->accept(*this);
+    }
+}
+
+void BoundsCheckEliminator::visit(ExitNode &) {}
@@ -0,0 +1,133 @@
+/*
+ * Analysis pass that removes redundant array bounds checks in the Oberon LLVM compiler.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#ifndef OBERON_LANG_BOUNDSCHECKELIMINATOR_H
+#define OBERON_LANG_BOUNDSCHECKELIMINATOR_H
+
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Analyzer.h"
+#include "data/ast/NodeVisitor.h"
+
+using std::optional;
+using std::pair;
+using std::set;
+using std::unique_ptr;
+using std::vector;
+
+// Range analysis of the array indices in FOR loops. An index that is the counter of a loop plus a constant is
+// always in bounds if the range of the counter is known, either from constant bounds or from bounds that are
+// derived from the length of the array, e.g., `FOR i := 0 TO LEN(a) - 1 DO a[i] ... END`. The bounds check of
+// such an index is redundant. The bounds check of an index that is the counter of a loop with bounds that are not
+// known, or a variable that is not modified by a loop, is hoisted out of that loop: the loop checks the bounds of
+// the whole index range once before it is entered. If that check succeeds, the guarded indices are not checked
+// again, otherwise the loop is executed with all checks in place. As the body of such a loop is generated twice,
+// only loops that do not contain another loop with guarded indices are guarded, so that the code of nested loops
+// grows linearly. The guarded indices of an enclosing loop are checked in every iteration instead.
+class BoundsCheckEliminator final : public Analysis, private NodeVisitor {
+
+private:
+    // Value that is the length of a dimension of an open array (or zero, if `array` is nullptr) plus an offset.
+    struct Bound {
+        DeclarationNode *array;
+        uint32_t dimension;
+        int64_t offset;
+    };
+
+    struct Loop {
+        ForLoopNode *node;
+        DeclarationNode *counter;
+        bool valid;       // the counter is a local variable that is not modified by the loop
+        bool invariant;   // the upper bound of the loop is not modified by the loop
+        optional<Bound> min, max;
+        set<DeclarationNode *> modified;
+        vector<pair<ArrayIndex *, size_t>> guarded;
+        bool nested;      // the loop contains another loop with guarded indices
+        unsigned removed, hoisted;
+    };
+
+    CompilerConfig &config_;
+    Logger *logger_;
+    vector<Loop> loops_;
+    set<DeclarationNode *> *modified_;
+
+    static optional<Bound> bound(ExpressionNode *);
+    static optional<pair<QualifiedExpression *, int64_t>> affine(ExpressionNode *);
+    static bool isLocal(const DeclarationNode *);
+    static bool isInvariant(ExpressionNode *, const set<DeclarationNode *> &);
+    static bool isVarArgument(DeclarationNode *, ProcedureTypeNode *, size_t);
+    static bool isInBounds(const Bound &, const Bound &, int64_t, const Bound &);
+
+    void guard(Loop &, QualifiedExpression *, int64_t, ArrayTypeNode *, DeclarationNode *, uint32_t);
+    void check(ArrayIndex *, ArrayTypeNode *, DeclarationNode *);
+    void modifies(ExpressionNode *);
+    void selectors(DeclarationNode *, vector<unique_ptr<Selector>> &);
+
+    void visit(ModuleNode &) override;
+    void visit(ProcedureDeclarationNode &) override;
+    void visit(ProcedureDefinitionNode &) override;
+
+    void visit(ImportNode &) override;
+
+    void visit(ConstantDeclarationNode &) override;
+    void visit(FieldNode &) override;
+    void visit(ParameterNode &) override;
+    void visit(TypeDeclarationNode &) override;
+    void visit(VariableDeclarationNode &) override;
+
+    void visit(QualifiedStatement &) override;
+    void visit(QualifiedExpression &) override;
+
+    void visit(BooleanLiteralNode &) override;
+    void visit(IntegerLiteralNode &) override;
+    void visit(RealLiteralNode &) override;
+    void visit(StringLiteralNode &) override;
+    void visit(CharLiteralNode &) override;
+    void visit(NilLiteralNode &) override;
+    void visit(SetLiteralNode &) override;
+    void visit(RangeLiteralNode &) override;
+
+    void visit(UnaryExpressionNode &) override;
+    void visit(BinaryExpressionNode &) override;
+    void visit(RangeExpressionNode &) override;
+    void visit(SetExpressionNode &) override;
+
+    void visit(ArrayTypeNode &) override;
+    void visit(BasicTypeNode &) override;
+    void visit(ProcedureTypeNode &) override;
+    void visit(RecordTypeNode &) override;
+    void visit(PointerTypeNode &) override;
+
+    void visit(StatementSequenceNode &) override;
+    void visit(AssignmentNode &) override;
+    void visit(CaseOfNode &) override;
+    void visit(CaseLabelNode &) override;
+    void visit(CaseNode &) override;
+    void visit(IfThenElseNode &) override;
+    void visit(ElseIfNode &) override;
+    void visit(LoopNode &) override;
+    void visit(WhileLoopNode &) override;
+    void visit(RepeatLoopNode &) override;
+    void visit(ForLoopNode &) override;
+    void visit(ReturnNode &) override;
+    void visit(ExitNode &) override;
+
+public:
+    explicit BoundsCheckEliminator(CompilerConfig &config) :
+            config_(config), logger_(), loops_(), modified_() {};
+    ~BoundsCheckEliminator() override = default;
+
+    void run(Logger &, Node *) override;
+
+};
+
+
+#endif //OBERON_LANG_BOUNDSCHECKELIMINATOR_H
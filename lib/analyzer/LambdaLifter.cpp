@@ -14,7 +14,6 @@
 
 #include "data/symtab/SymbolTable.h"
 
-using std::make_unique;
 using std::string;
 using std::stringstream;
 using std::unique_ptr;
@@ -46,41 +45,41 @@ void LambdaLifter::visit(ProcedureDefinitionNode &node) {
     if (is_super) /* super procedure */ {
         if (!node.getType()->parameters().empty() || node.getVariableCount() > 0) {
             // create a record type for the procedure's environment, containing fields for all parameters and variables
-            auto identifier = make_unique<IdentDef>("_T" + node.getIdentifier()->name());
+            auto identifier = context_->make<IdentDef>("_T" + node.getIdentifier()->name());
             vector<unique_ptr<FieldNode>> fields;
             for (auto &param : node.getType()->parameters()) {
-                auto ident = make_unique<IdentDef>(param->getIdentifier()->name());
-                fields.push_back(make_unique<FieldNode>(EMPTY_POS, std::move(ident), param->getType()));
+                auto ident = context_->make<IdentDef>(param->getIdentifier()->name());
+                fields.push_back(context_->make<FieldNode>(EMPTY_POS, std::move(ident), param->getType()));
             }
             for (size_t i = 0; i < node.getVariableCount(); i++) {
                 auto var = node.getVariable(i);
-                auto ident = make_unique<IdentDef>(var->getIdentifier()->name());
-                fields.push_back(make_unique<FieldNode>(EMPTY_POS, std::move(ident), var->getType()));
+                auto ident = context_->make<IdentDef>(var->getIdentifier()->name());
+                fields.push_back(context_->make<FieldNode>(EMPTY_POS, std::move(ident), var->getType()));
             }
             auto type = context_->getOrInsertRecordType(EMPTY_POS, EMPTY_POS, nullptr, std::move(fields));
-            auto decl = make_unique<TypeDeclarationNode>(EMPTY_POS, std::move(identifier), type);
+            auto decl = context_->make<TypeDeclarationNode>(EMPTY_POS, std::move(identifier), type);
             decl->setModule(module_);
             decl->setScope(module_->getScope() + 1);
             module_->types().push_back(std::move(decl));
             // insert an additional formal parameter to the sub-procedures of the procedure to pass its environment
             for (auto &proc : node.procedures()) {
-                auto param = make_unique<ParameterNode>(EMPTY_POS, make_unique<Ident>(SUPER_), type, true);
+                auto param = context_->make<ParameterNode>(EMPTY_POS, context_->make<Ident>(SUPER_), type, true);
                 param->setScope(proc->getScope() + 1);
                 proc->getType()->parameters().push_back(std::move(param));
             }
             // create local variable to manage for the procedure's environment (this)
-            auto var = make_unique<VariableDeclarationNode>(EMPTY_POS, make_unique<IdentDef>(THIS_), type);
+            auto var = context_->make<VariableDeclarationNode>(EMPTY_POS, context_->make<IdentDef>(THIS_), type);
             var->setScope(scope_ + 1);
             env_ = var.get();
             // initialize the procedure's environment (this)
             for (size_t i = 0; i < node.getType()->parameters().size(); i++) {
                 auto param = node.getType()->parameters()[i].get();
-                auto lhs = make_unique<QualifiedExpression>(env_);
+                auto lhs = context_->make<QualifiedExpression>(env_);
                 auto field = type->getField(param->getIdentifier()->name());
-                lhs->selectors().push_back(make_unique<RecordField>(EMPTY_POS, field));
+                lhs->selectors().push_back(context_->make<RecordField>(EMPTY_POS, field));
                 lhs->setType(field->getType());
-                auto rhs = make_unique<QualifiedExpression>(param);
-                node.statements()->insertStatement(i, make_unique<AssignmentNode>(EMPTY_POS, std::move(lhs), std::move(rhs)));
+                auto rhs = context_->make<QualifiedExpression>(param);
+                node.statements()->insertStatement(i, context_->make<AssignmentNode>(EMPTY_POS, std::move(lhs), std::move(rhs)));
             }
             node.insertVariable(0, std::move(var));
             // alter the statements of the procedure to use the procedure's environment (this)
@@ -90,24 +89,24 @@ void LambdaLifter::visit(ProcedureDefinitionNode &node) {
             // append statements to write values of var-parameters back from procedure's environment (this)
             for (auto &param : node.getType()->parameters()) {
                 if (param->isVar() && param->getIdentifier()->name() != SUPER_) {
-                    auto lhs = make_unique<QualifiedExpression>(param.get());
-                    auto rhs = make_unique<QualifiedExpression>(env_);
+                    auto lhs = context_->make<QualifiedExpression>(param.get());
+                    auto rhs = context_->make<QualifiedExpression>(env_);
                     auto field = type->getField(param->getIdentifier()->name());
-                    rhs->selectors().push_back(make_unique<RecordField>(EMPTY_POS, field));
+                    rhs->selectors().push_back(context_->make<RecordField>(EMPTY_POS, field));
                     rhs->setType(field->getType());
-                    node.statements()->addStatement(make_unique<AssignmentNode>(EMPTY_POS, std::move(lhs), std::move(rhs)));
+                    node.statements()->addStatement(context_->make<AssignmentNode>(EMPTY_POS, std::move(lhs), std::move(rhs)));
                 }
             }
             // write updates back to super-procedure's environment (super := this.super)
             if (scope_ > SymbolTable::MODULE_SCOPE) /* neither root, nor leaf procedure */ {
                 auto param = findParameter(SUPER_, node.getType()->parameters());
                 if (param) {
-                    auto lhs = make_unique<QualifiedExpression>(param);
-                    auto rhs = make_unique<QualifiedExpression>(env_);
+                    auto lhs = context_->make<QualifiedExpression>(param);
+                    auto rhs = context_->make<QualifiedExpression>(env_);
                     auto field = type->getField(SUPER_);
-                    rhs->selectors().push_back(make_unique<RecordField>(EMPTY_POS, field));
+                    rhs->selectors().push_back(context_->make<RecordField>(EMPTY_POS, field));
                     rhs->setType(field->getType());
-                    node.statements()->addStatement(make_unique<AssignmentNode>(EMPTY_POS, std::move(lhs), std::move(rhs)));
+                    node.statements()->addStatement(context_->make<AssignmentNode>(EMPTY_POS, std::move(lhs), std::move(rhs)));
                 }
             }
         }
@@ -119,7 +118,7 @@ void LambdaLifter::visit(ProcedureDefinitionNode &node) {
             }
             auto proc = node.getProcedure(i);
             ss << proc->getIdentifier()->name();
-            proc->setIdentifier(make_unique<IdentDef>(ss.str()));
+            proc->setIdentifier(context_->make<IdentDef>(ss.str()));
             module_->addProcedure(node.removeProcedure(i));
         }
         // TODO remove unnecessary local variables
@@ -210,7 +209,7 @@ void LambdaLifter::selectors(TypeNode *base, vector<unique_ptr<Selector>> &selec
             auto type = dynamic_cast<ProcedureTypeNode *>(base);
             // process procedure environment parameter
             if (type->parameters().size() > params->parameters().size()) {
-                auto param = make_unique<QualifiedExpression>(env_);
+                auto param = context_->make<QualifiedExpression>(env_);
                 params->parameters().push_back(std::move(param));
             }
             base = type->getReturnType();
@@ -361,20 +360,20 @@ void LambdaLifter::visit(ReturnNode &node) {
 
 void LambdaLifter::visit(ExitNode &) {}
 
-bool LambdaLifter::envFieldResolver(QualifiedExpression *var, const std::string &field_name, TypeNode *field_type) {
+bool LambdaLifter::envFieldResolver(QualifiedExpression *var, const std::string &field_name, TypeNode *field_type) const {
     auto type = dynamic_cast<RecordTypeNode*>(var->getType());
     auto &selectors = var->selectors();
     long num = 0;
     while (true) {
         auto field = type->getField(field_name);
         if (field && field->getType() == field_type) {
-            selectors.insert(selectors.begin() + num, make_unique<RecordField>(EMPTY_POS, field));
+            selectors.insert(selectors.begin() + num, context_->make<RecordField>(EMPTY_POS, field));
             var->setType(field->getType());
             return true;
         } else {
             field = type->getField(SUPER_);
             if (field) {
-                selectors.insert(selectors.begin() + num, make_unique<RecordField>(EMPTY_POS, field));
+                selectors.insert(selectors.begin() + num, context_->make<RecordField>(EMPTY_POS, field));
                 type = dynamic_cast<RecordTypeNode *>(field->getType());
                 num++;
             } else {
@@ -88,7 +88,7 @@ private:
     void visit(ReturnNode &) override;
     void visit(ExitNode &) override;
 
-    static bool envFieldResolver(QualifiedExpression *, const string &, TypeNode *);
+    bool envFieldResolver(QualifiedExpression *, const string &, TypeNode *) const;
 
 public:
     explicit LambdaLifter(ASTContext *context) : context_(context), module_(), env_(), scope_(), path_() { };
@@ -0,0 +1,445 @@
+/*
+ * Analysis pass that combines or removes integer overflow checks in the Oberon LLVM compiler.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#include "OverflowCheckCombiner.h"
+
+#include <algorithm>
+#include <string>
+
+#include "data/symtab/SymbolTable.h"
+#include "system/PredefinedProcedure.h"
+
+using std::string;
+using std::to_string;
+
+// Values beyond this limit are not considered, so that the range of an expression cannot overflow.
+static constexpr int64_t RANGE_LIMIT = INT32_MAX;
+
+static bool isInRange(const int64_t value) {
+    return value >= -RANGE_LIMIT && value <= RANGE_LIMIT;
+}
+
+void OverflowCheckCombiner::run(Logger &logger, Node *node) {
+    if (logger.getErrorCount() == 0 && config_.isSanitized(Trap::INT_OVERFLOW)) {
+        logger_ = &logger;
+        node->accept(*this);
+    }
+}
+
+bool OverflowCheckCombiner::isLocal(const DeclarationNode *decl) {
+    // Local variables and value parameters can only be modified by the procedure itself or by passing them as
+    // variable parameters, as the variables of procedures with nested procedures are moved to their environment
+    if (!decl || decl->getScope() <= SymbolTable::MODULE_SCOPE) {
+        return false;
+    }
+    if (decl->getNodeType() == NodeType::parameter) {
+        return !dynamic_cast<const ParameterNode *>(decl)->isVar();
+    }
+    return decl->getNodeType() == NodeType::variable;
+}
+
+bool OverflowCheckCombiner::isPure(DeclarationNode *decl) {
+    if (const auto proc = dynamic_cast<PredefinedProcedure *>(decl)) {
+        switch (proc->getKind()) {
+            case ProcKind::ABS: case ProcKind::ASH: case ProcKind::ASR: case ProcKind::CAP:
+            case ProcKind::CHR: case ProcKind::COPY: case ProcKind::DEC:
+            case ProcKind::ENTIER: case ProcKind::EXCL: case ProcKind::FLOOR: case ProcKind::FLT:
+            case ProcKind::INC: case ProcKind::INCL: case ProcKind::LEN: case ProcKind::LONG:
+            case ProcKind::LSL: case ProcKind::MAX: case ProcKind::MIN: case ProcKind::ODD:
+            case ProcKind::ORD: case ProcKind::PACK: case ProcKind::ROR: case ProcKind::SHORT:
+            case ProcKind::SIZE: case ProcKind::UNPK: case ProcKind::SYSTEM_SIZE: case ProcKind::SYSTEM_VAL:
+                return true;
+            default:
+                // NEW, DISPOSE, and HALT have effects outside the procedure, ASSERT traps before the overflow if its
+                // condition is computed from a value that has overflowed, SYSTEM.ADR, SYSTEM.GET, SYSTEM.PUT,
+                // SYSTEM.BIT, and SYSTEM.COPY access memory through addresses that might be computed from a
+                // value that has overflowed
+                return false;
+        }
+    }
+    return false;
+}
+
+bool OverflowCheckCombiner::isChecked(BinaryExpressionNode &node) const {
+    switch (node.getOperator()) {
+        case OperatorType::DIV: case OperatorType::MOD: {
+            const auto divisor = dynamic_cast<IntegerLiteralNode *>(node.getRightExpression());
+            return (config_.isSanitized(Trap::INT_DIVISION) || config_.isSanitized(Trap::SIGN_CONVERSION)) &&
+                   (!divisor || divisor->value() <= 0);
+        }
+        case OperatorType::DIVIDE:
+            return config_.isSanitized(Trap::FLT_DIVISION);
+        default:
+            return false;
+    }
+}
+
+bool OverflowCheckCombiner::isInvariant(ExpressionNode *expr, const set<DeclarationNode *> &modified) {
+    if (expr->isLiteral()) {
+        return true;
+    }
+    if (const auto unary = dynamic_cast<UnaryExpressionNode *>(expr)) {
+        return isInvariant(unary->getExpression(), modified);
+    }
+    if (const auto binary = dynamic_cast<BinaryExpressionNode *>(expr)) {
+        return isInvariant(binary->getLeftExpression(), modified) &&
+               isInvariant(binary->getRightExpression(), modified);
+    }
+    const auto qual = dynamic_cast<QualifiedExpression *>(expr);
+    if (!qual) {
+        return false;
+    }
+    const auto decl = qual->dereference();
+    if (qual->selectors().empty()) {
+        return (isLocal(decl) && !modified.contains(decl)) || (decl && decl->getNodeType() == NodeType::constant);
+    }
+    // The length of an array never changes
+    const auto proc = dynamic_cast<PredefinedProcedure *>(decl);
+    if (!proc || proc->getKind() != ProcKind::LEN || qual->selectors().size() != 1 ||
+        qual->selectors()[0]->getNodeType() != NodeType::parameter) {
+        return false;
+    }
+    const auto &params = dynamic_cast<ActualParameters *>(qual->selectors()[0].get())->parameters();
+    const auto array = params.empty() ? nullptr : dynamic_cast<QualifiedExpression *>(params[0].get());
+    return array && array->selectors().empty() && (params.size() == 1 || params[1]->isLiteral());
+}
+
+optional<OverflowCheckCombiner::Range> OverflowCheckCombiner::range(const OperatorType op, const optional<Range> &lhs,
+                                                                     const optional<Range> &rhs) {
+    if (!lhs || !rhs) {
+        return std::nullopt;
+    }
+    switch (op) {
+        case OperatorType::PLUS:
+            return Range{lhs->first + rhs->first, lhs->second + rhs->second};
+        case OperatorType::MINUS:
+            return Range{lhs->first - rhs->second, lhs->second - rhs->first};
+        case OperatorType::TIMES: {
+            const auto products = {lhs->first * rhs->first, lhs->first * rhs->second,
+                                   lhs->second * rhs->first, lhs->second * rhs->second};
+            return Range{std::min(products), std::max(products)};
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+optional<OverflowCheckCombiner::Range> OverflowCheckCombiner::range(ExpressionNode *expr) const {
+    optional<Range> result;
+    if (const auto literal = dynamic_cast<IntegerLiteralNode *>(expr)) {
+        result = Range{literal->value(), literal->value()};
+    } else if (const auto binary = dynamic_cast<BinaryExpressionNode *>(expr)) {
+        // Only expressions that are proven not to overflow have the value that is computed from their operands
+        if (!binary->canOverflow()) {
+            result = range(binary->getOperator(), range(binary->getLeftExpression()),
+                           range(binary->getRightExpression()));
+        }
+    } else if (const auto qual = dynamic_cast<QualifiedExpression *>(expr)) {
+        const auto ref = qual->dereference();
+        const auto loop = std::find_if(loops_.rbegin(), loops_.rend(), [ref](const Loop &l) {
+            return ref && l.counter == ref;
+        });
+        if (qual->selectors().empty() && loop != loops_.rend() && loop->min && loop->max) {
+            result = Range{loop->min.value(), loop->max.value()};
+        }
+    }
+    if (result && (!isInRange(result->first) || !isInRange(result->second))) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+void OverflowCheckCombiner::combine(BinaryExpressionNode &node) {
+    if (!node.getType() || !node.getType()->isInteger()) {
+        return;
+    }
+    const auto result = range(node.getOperator(), range(node.getLeftExpression()),
+                              range(node.getRightExpression()));
+    if (!result) {
+        return;
+    }
+    // The result is checked for signed overflow in the width of its type
+    const auto bits = node.getType()->getSize() * 8;
+    if (bits < 64 && (result->first < -(INT64_C(1) << (bits - 1)) || result->second >= (INT64_C(1) << (bits - 1)))) {
+        return;
+    }
+    node.setOverflow(false);
+    ++loops_.back().removed;
+}
+
+void OverflowCheckCombiner::modifies(ExpressionNode *expr) {
+    if (const auto qual = dynamic_cast<QualifiedExpression *>(expr)) {
+        body_->modified.insert(qual->dereference());
+    }
+}
+
+void OverflowCheckCombiner::selectors(DeclarationNode *decl, vector<unique_ptr<Selector>> &selectors) {
+    for (size_t i = 0; i < selectors.size(); ++i) {
+        const auto sel = selectors[i].get();
+        if (sel->getNodeType() == NodeType::parameter) {
+            if (body_ && (i > 0 || !isPure(decl))) {
+                body_->effects = true;
+            }
+            for (const auto &param : dynamic_cast<ActualParameters *>(sel)->parameters()) {
+                param->accept(*this);
+                if (body_) {
+                    modifies(param.get());
+                }
+            }
+            if (!body_ && !loops_.empty() && loops_.back().node->hasDeferredOverflow() && i == 0) {
+                const auto proc = dynamic_cast<PredefinedProcedure *>(decl);
+                if (proc && (proc->getKind() == ProcKind::INC || proc->getKind() == ProcKind::DEC)) {
+                    ++loops_.back().deferred;
+                }
+            }
+        } else if (sel->getNodeType() == NodeType::array_type) {
+            const auto array = dynamic_cast<ArrayIndex *>(sel);
+            for (size_t j = 0; j < array->indices().size(); ++j) {
+                // An index that has overflowed traps with an out-of-bounds check first
+                if (body_ && config_.isSanitized(Trap::OUT_OF_BOUNDS) && array->getCheck(j) != BoundsCheck::REDUNDANT) {
+                    body_->effects = true;
+                }
+                array->indices()[j]->accept(*this);
+            }
+        }
+    }
+}
+
+void OverflowCheckCombiner::visit(ModuleNode &node) {
+    for (size_t i = 0; i < node.getProcedureCount(); i++) {
+        node.getProcedure(i)->accept(*this);
+    }
+    node.statements()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(ProcedureDeclarationNode &) {}
+
+void OverflowCheckCombiner::visit(ProcedureDefinitionNode &node) {
+    for (size_t i = 0; i < node.getProcedureCount(); i++) {
+        node.getProcedure(i)->accept(*this);
+    }
+    node.statements()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(ImportNode &) {}
+
+void OverflowCheckCombiner::visit(ConstantDeclarationNode &) {}
+
+void OverflowCheckCombiner::visit(FieldNode &) {}
+
+void OverflowCheckCombiner::visit(ParameterNode &) {}
+
+void OverflowCheckCombiner::visit(TypeDeclarationNode &) {}
+
+void OverflowCheckCombiner::visit(VariableDeclarationNode &) {}
+
+void OverflowCheckCombiner::visit(QualifiedStatement &node) {
+    // Procedures without parameters are called without an actual parameters selector
+    if (body_ && !isPure(node.dereference())) {
+        body_->effects = true;
+    }
+    selectors(node.dereference(), node.selectors());
+}
+
+void OverflowCheckCombiner::visit(QualifiedExpression &node) {
+    selectors(node.dereference(), node.selectors());
+}
+
+void OverflowCheckCombiner::visit(BooleanLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(IntegerLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(RealLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(StringLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(CharLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(NilLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(SetLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(RangeLiteralNode &) {}
+
+void OverflowCheckCombiner::visit(UnaryExpressionNode &node) {
+    node.getExpression()->accept(*this);
+    if (!body_ && !loops_.empty() && loops_.back().node->hasDeferredOverflow() &&
+        node.getOperator() == OperatorType::NEG && node.getType() && node.getType()->isInteger()) {
+        ++loops_.back().deferred;
+    }
+}
+
+void OverflowCheckCombiner::visit(BinaryExpressionNode &node) {
+    node.getLeftExpression()->accept(*this);
+    node.getRightExpression()->accept(*this);
+    if (body_) {
+        // A divisor that has overflowed traps with a division check first
+        if (isChecked(node)) {
+            body_->effects = true;
+        }
+        return;
+    }
+    if (loops_.empty()) {
+        return;
+    }
+    combine(node);
+    const auto op = node.getOperator();
+    if (node.canOverflow() && loops_.back().node->hasDeferredOverflow() && node.getType()->isInteger() &&
+        (op == OperatorType::PLUS || op == OperatorType::MINUS || op == OperatorType::TIMES)) {
+        ++loops_.back().deferred;
+    }
+}
+
+void OverflowCheckCombiner::visit(RangeExpressionNode &node) {
+    node.getLower()->accept(*this);
+    node.getUpper()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(SetExpressionNode &node) {
+    for (auto &element : node.elements()) {
+        element->accept(*this);
+    }
+}
+
+void OverflowCheckCombiner::visit(ArrayTypeNode &) {}
+
+void OverflowCheckCombiner::visit(BasicTypeNode &) {}
+
+void OverflowCheckCombiner::visit(ProcedureTypeNode &) {}
+
+void OverflowCheckCombiner::visit(RecordTypeNode &) {}
+
+void OverflowCheckCombiner::visit(PointerTypeNode &) {}
+
+void OverflowCheckCombiner::visit(StatementSequenceNode &node) {
+    for (size_t i = 0; i < node.getStatementCount(); i++) {
+        node.getStatement(i)->accept(*this);
+    }
+}
+
+void OverflowCheckCombiner::visit(AssignmentNode &node) {
+    node.getLvalue()->accept(*this);
+    node.getRvalue()->accept(*this);
+    if (body_) {
+        modifies(node.getLvalue());
+    }
+}
+
+void OverflowCheckCombiner::visit(CaseOfNode &node) {
+    node.getExpression()->accept(*this);
+    for (size_t i = 0; i < node.getCaseCount(); ++i) {
+        node.getCase(i)->accept(*this);
+    }
+    if (node.hasElse()) {
+        node.getElseStatements()->accept(*this);
+    }
+}
+
+void OverflowCheckCombiner::visit(CaseLabelNode &node) {
+    for (size_t i = 0; i < node.getValueCount(); ++i) {
+        node.getValue(i)->accept(*this);
+    }
+}
+
+void OverflowCheckCombiner::visit(CaseNode &node) {
+    node.getLabel()->accept(*this);
+    node.getStatements()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(IfThenElseNode &node) {
+    node.getCondition()->accept(*this);
+    node.getThenStatements()->accept(*this);
+    for (size_t i = 0; i < node.getElseIfCount(); i++) {
+        node.getElseIf(i)->accept(*this);
+    }
+    if (node.hasElse()) {
+        node.getElseStatements()->accept(*this);
+    }
+}
+
+void OverflowCheckCombiner::visit(ElseIfNode &node) {
+    node.getCondition()->accept(*this);
+    node.getStatements()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(LoopNode &node) {
+    if (body_) {
+        body_->effects = true;
+    }
+    node.getStatements()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(WhileLoopNode &node) {
+    // A loop whose condition depends on a value that has overflowed might not terminate
+    if (body_) {
+        body_->effects = true;
+    }
+    node.getCondition()->accept(*this);
+    node.getStatements()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(RepeatLoopNode &node) {
+    if (body_) {
+        body_->effects = true;
+    }
+    node.getStatements()->accept(*this);
+    node.getCondition()->accept(*this);
+}
+
+void OverflowCheckCombiner::visit(ForLoopNode &node) {
+    node.getLow()->accept(*this);
+    node.getHigh()->accept(*this);
+    const auto counter = node.getCounter()->dereference();
+    if (body_) {
+        body_->modified.insert(counter);
+        node.getStatements()->accept(*this);
+        return;
+    }
+    // Collect the properties of the loop body, including the high bound that is evaluated in every iteration
+    Body body{false, {}};
+    body_ = &body;
+    node.getHigh()->accept(*this);
+    node.getStatements()->accept(*this);
+    body_ = nullptr;
+    // The counter cannot overflow if the high bound, which is checked once before the loop is entered, is invariant
+    node.setDeferredOverflow(config_.hasFlag(Flag::DEFER_OVERFLOW) && !body.effects &&
+                             isInvariant(node.getHigh(), body.modified));
+    Loop loop{&node, counter, std::nullopt, std::nullopt, 0, 0};
+    if (node.getCounter()->selectors().empty() && isLocal(counter) && !body.modified.contains(counter)) {
+        const auto step = dynamic_cast<IntegerLiteralNode *>(node.getStep())->value();
+        const auto low = dynamic_cast<IntegerLiteralNode *>(node.getLow());
+        const auto high = dynamic_cast<IntegerLiteralNode *>(node.getHigh());
+        if (low && high && isInRange(low->value()) && isInRange(high->value())) {
+            // The body is only executed with values of the counter between the low and the high bound
+            loop.min = step > 0 ? low->value() : high->value();
+            loop.max = step > 0 ? high->value() : low->value();
+        }
+    }
+    loops_.push_back(loop);
+    node.getStatements()->accept(*this);
+    const auto removed = loops_.back().removed;
+    const auto deferred = loops_.back().deferred;
+    loops_.pop_back();
+    if (config_.hasRemark(Remark::OVERFLOW_CHECK) && (removed > 0 || deferred > 0)) {
+        logger_->remark(node.pos(), to_string(removed) + " overflow check(s) removed, " + to_string(deferred) +
+                                    " overflow check(s) deferred to loop exit [-Rpass=overflow-check]");
+    }
+}
+
+void OverflowCheckCombiner::visit(ReturnNode &node) {
+    if (body_) {
+        body_->effects = true;
+    }
+    if (node.getValue()) {
+        node.getValue()->accept(*this);
+    }
+}
+
+void OverflowCheckCombiner::visit(ExitNode &) {
+    if (body_) {
+        body_->effects = true;
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Analysis pass that combines or removes integer overflow checks in the Oberon LLVM compiler.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#ifndef OBERON_LANG_OVERFLOWCHECKCOMBINER_H
+#define OBERON_LANG_OVERFLOWCHECKCOMBINER_H
+
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Analyzer.h"
+#include "data/ast/NodeVisitor.h"
+
+using std::optional;
+using std::pair;
+using std::set;
+using std::unique_ptr;
+using std::vector;
+
+// Overflow checks of integer arithmetic in FOR loops. An expression that adds a constant to, subtracts a constant
+// from, or multiplies a constant with the counter of a loop with constant bounds is proven not to overflow, if the
+// result for both bounds is representable in the type of the expression. Such an expression is not checked at all.
+// If enabled, the remaining checks in the body of a loop that neither calls a procedure, nor leaves the loop early,
+// nor contains a loop that is not counted, nor modifies its high bound, nor contains another check that traps, i.e.,
+// an assertion, a checked array index, or a checked division, are combined into a flag that is checked once the loop
+// is exited. As such a loop always terminates, the overflow still traps, only later. The body may have
+// stored wrapped values to global variables or variable parameters by then, but the program is aborted anyway before
+// it can observe them. The counter of such a loop is checked once before the loop is entered.
+class OverflowCheckCombiner final : public Analysis, private NodeVisitor {
+
+private:
+    using Range = pair<int64_t, int64_t>;
+
+    struct Loop {
+        ForLoopNode *node;
+        DeclarationNode *counter;
+        optional<int64_t> min, max;   // range of the counter, if the loop has constant bounds
+        unsigned removed, deferred;
+    };
+
+    // Properties of a loop body that are collected before the loop is analyzed
+    struct Body {
+        bool effects;   // the body calls a procedure, leaves the loop early, has a loop that is not counted, or traps
+        set<DeclarationNode *> modified;
+    };
+
+    CompilerConfig &config_;
+    Logger *logger_;
+    vector<Loop> loops_;
+    Body *body_;
+
+    static bool isLocal(const DeclarationNode *);
+    static bool isPure(DeclarationNode *);
+    static bool isInvariant(ExpressionNode *, const set<DeclarationNode *> &);
+    static optional<Range> range(OperatorType, const optional<Range> &, const optional<Range> &);
+
+    [[nodiscard]] bool isChecked(BinaryExpressionNode &) const;
+    [[nodiscard]] optional<Range> range(ExpressionNode *) const;
+
+    void combine(BinaryExpressionNode &);
+    void modifies(ExpressionNode *);
+    void selectors(DeclarationNode *, vector<unique_ptr<Selector>> &);
+
+    void visit(ModuleNode &) override;
+    void visit(ProcedureDeclarationNode &) override;
+    void visit(ProcedureDefinitionNode &) override;
+
+    void visit(ImportNode &) override;
+
+    void visit(ConstantDeclarationNode &) override;
+    void visit(FieldNode &) override;
+    void visit(ParameterNode &) override;
+    void visit(TypeDeclarationNode &) override;
+    void visit(VariableDeclarationNode &) override;
+
+    void visit(QualifiedStatement &) override;
+    void visit(QualifiedExpression &) override;
+
+    void visit(BooleanLiteralNode &) override;
+    void visit(IntegerLiteralNode &) override;
+    void visit(RealLiteralNode &) override;
+    void visit(StringLiteralNode &) override;
+    void visit(CharLiteralNode &) override;
+    void visit(NilLiteralNode &) override;
+    void visit(SetLiteralNode &) override;
+    void visit(RangeLiteralNode &) override;
+
+    void visit(UnaryExpressionNode &) override;
+    void visit(BinaryExpressionNode &) override;
+    void visit(RangeExpressionNode &) override;
+    void visit(SetExpressionNode &) override;
+
+    void visit(ArrayTypeNode &) override;
+    void visit(BasicTypeNode &) override;
+    void visit(ProcedureTypeNode &) override;
+    void visit(RecordTypeNode &) override;
+    void visit(PointerTypeNode &) override;
+
+    void visit(StatementSequenceNode &) override;
+    void visit(AssignmentNode &) override;
+    void visit(CaseOfNode &) override;
+    void visit(CaseLabelNode &) override;
+    void visit(CaseNode &) override;
+    void visit(IfThenElseNode &) override;
+    void visit(ElseIfNode &) override;
+    void visit(LoopNode &) override;
+    void visit(WhileLoopNode &) override;
+    void visit(RepeatLoopNode &) override;
+    void visit(ForLoopNode &) override;
+    void visit(ReturnNode &) override;
+    void visit(ExitNode &) override;
+
+public:
+    explicit OverflowCheckCombiner(CompilerConfig &config) :
+            config_(config), logger_(), loops_(), body_() {};
+    ~OverflowCheckCombiner() override = default;
+
+    void run(Logger &, Node *) override;
+
+};
+
+
+#endif //OBERON_LANG_OVERFLOWCHECKCOMBINER_H
@@ -24,6 +24,8 @@ public:
     virtual void configure() = 0;
 
     virtual void generate(ASTContext *, path) = 0;
+    // Returns the path of the output file that is generated for the given source file.
+    [[nodiscard]] virtual path getOutputFile(const path &) const = 0;
 #ifndef _LLVM_LEGACY
     virtual int jit(ASTContext *ast, path) = 0;
 #endif
@@ -5,20 +5,34 @@
  */
 
 #include "LLVMCodeGen.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <unordered_set>
+#include <vector>
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/BuiltinGCs.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Object/ArchiveWriter.h>
 #include <llvm/Support/ErrorOr.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/VirtualFileSystem.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 #include "LLVMIRBuilder.h"
+#include "compiler/ThreadPool.h"
 
 using namespace llvm;
 
@@ -132,18 +146,99 @@ void register_signal_handler() {
 #endif
 }
 
+#ifdef _LLVM_LEGACY
+LLVMCodeGenTarget::LLVMCodeGenTarget(string key, TargetMachine *tm, const std::optional<PGOOptions> &) :
+        key(std::move(key)), tm(tm) {
+#else
+LLVMCodeGenTarget::LLVMCodeGenTarget(string key, TargetMachine *tm, const std::optional<PGOOptions> &pgo) :
+        key(std::move(key)), tm(tm), pb(nullptr, PipelineTuningOptions(), pgo) {
+#endif
+    // Register all the basic analyses with the managers
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+}
+
+static int64_t millis(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+static std::mutex targetsLock;
+// intentionally never destroyed, as target machines must not outlive the LLVM libraries at exit
+static auto *targets = new std::map<string, std::vector<unique_ptr<LLVMCodeGenTarget>>>();
+
+static unique_ptr<LLVMCodeGenTarget> acquireTarget(const string &key) {
+    std::lock_guard guard(targetsLock);
+    auto &pool = (*targets)[key];
+    if (pool.empty()) {
+        return nullptr;
+    }
+    auto target = std::move(pool.back());
+    pool.pop_back();
+    return target;
+}
+
+static void releaseTarget(unique_ptr<LLVMCodeGenTarget> target) {
+    std::lock_guard guard(targetsLock);
+    (*targets)[target->key].push_back(std::move(target));
+}
+
+// Initializes the LLVM back-end of the given target triple. Initializing all back-ends dominates the start-up time of
+// the compiler for small modules, hence only the native back-end or the back-end of the requested target is set up.
+static void initializeTarget(const string &tt, const bool native) {
+    if (native) {
+        InitializeNativeTarget();
+        InitializeNativeTargetAsmPrinter();
+        InitializeNativeTargetAsmParser();
+        return;
+    }
+    // Target infos are cheap to initialize and needed to map the triple to the name of its back-end
+    InitializeAllTargetInfos();
+#if defined(_LLVM_21) || defined(_LLVM_22)
+    Triple triple(tt);
+#else
+    string triple = tt;
+#endif
+    string error;
+    const auto target = TargetRegistry::lookupTarget(triple, error);
+    if (!target) {
+        return;
+    }
+    const string name = target->getBackendName();
+#define LLVM_TARGET(TargetName) \
+    if (name == #TargetName) { \
+        LLVMInitialize##TargetName##Target(); \
+        LLVMInitialize##TargetName##TargetMC(); \
+    }
+#include <llvm/Config/Targets.def>
+#define LLVM_ASM_PRINTER(TargetName) \
+    if (name == #TargetName) { \
+        LLVMInitialize##TargetName##AsmPrinter(); \
+    }
+#include <llvm/Config/AsmPrinters.def>
+#define LLVM_ASM_PARSER(TargetName) \
+    if (name == #TargetName) { \
+        LLVMInitialize##TargetName##AsmParser(); \
+    }
+#include <llvm/Config/AsmParsers.def>
+}
+
 LLVMCodeGen::LLVMCodeGen(CompilerConfig &config) :
         config_(config), logger_(config_.logger()), type_(OutputFileType::ObjectFile), lvl_(llvm::OptimizationLevel::O0) {
-    // Initialize LLVM
-    // TODO some can be skipped when running JIT
-    InitializeAllTargetInfos();
-    InitializeAllTargets();
-    InitializeAllTargetMCs();
-    InitializeAllAsmParsers();
-    InitializeAllAsmPrinters();
+    // LLVM is initialized once the target triple is known, see configure()
     tm_ = nullptr;
     jit_ = nullptr;
     exitOnErr_.setBanner(logger_.getBanner() + ": [error] ");
+    // Link the built-in garbage collection strategies, the shadow stack is used to register roots with `-fgc`
+    linkAllBuiltinGCs();
+}
+
+LLVMCodeGen::~LLVMCodeGen() {
+    if (target_) {
+        releaseTarget(std::move(target_));
+    }
 }
 
 std::string LLVMCodeGen::getDescription() {
@@ -174,19 +269,29 @@ void LLVMCodeGen::configure() {
             lvl_ = llvm::OptimizationLevel::O0;
     }
     string tt = config_.getTargetTriple();
-    if (tt.empty()) {
+    const bool native = tt.empty();
+    if (native) {
         // Use default target triple of host as fallback
         tt = sys::getDefaultTargetTriple();
     }
     logger_.debug("Using target triple: " + tt + ".");
+    initializeTarget(tt, native || config_.isJit());
 #if defined(_LLVM_21) || defined(_LLVM_22)
     Triple triple(tt);
 #else
     string triple = tt;
 #endif
-    // Set up target
+    // Set up target, reusing the target machine of a previous code generator, if possible
+    if (target_) {
+        releaseTarget(std::move(target_));
+    }
+    const auto key = tt + ":" + to_string(static_cast<int>(config_.getRelocationModel())) + ":" +
+                     to_string(config_.hasFlag(Flag::PROFILE_GENERATE)) + ":" + config_.getProfileFile();
+    target_ = acquireTarget(key);
     string error;
-    if (const auto target = TargetRegistry::lookupTarget(triple, error); !target) {
+    if (target_) {
+        tm_ = target_->tm.get();
+    } else if (const auto target = TargetRegistry::lookupTarget(triple, error); !target) {
         logger_.error(string(), error);
     } else {
         // Set up target machine to match host
@@ -210,10 +315,28 @@ void LLVMCodeGen::configure() {
                 break;
         }
         tm_ = target->createTargetMachine(triple, cpu, features, opt, model);
+        target_ = std::make_unique<LLVMCodeGenTarget>(key, tm_, getPGOOptions());
     }
     // TODO Setup for JIT
     if (config_.isJit()) {
-        jit_ = exitOnErr_(orc::LLJITBuilder().create());
+        if (config_.hasFlag(Flag::TIERED_JIT)) {
+            // Procedures are compiled concurrently to the program, which requires a thread-safe compiler, and as fast
+            // as possible, as they are recompiled with optimizations once they are hot
+            auto machine = exitOnErr_(orc::JITTargetMachineBuilder::detectHost());
+#if defined(_LLVM_16) || defined(_LLVM_17)
+            machine.setCodeGenOptLevel(CodeGenOpt::None);
+#else
+            machine.setCodeGenOptLevel(CodeGenOptLevel::None);
+#endif
+            auto lazy = exitOnErr_(orc::LLLazyJITBuilder()
+                    .setJITTargetMachineBuilder(std::move(machine))
+                    .setNumCompileThreads(1)
+                    .create());
+            tiered_ = std::make_unique<LLVMTieredJIT>(logger_, *lazy, config_.getJitThreshold());
+            jit_ = std::move(lazy);
+        } else {
+            jit_ = exitOnErr_(orc::LLJITBuilder().create());
+        }
         // TODO Remove this when this is moved into compiler_rt for JIT
         // If this is a Mingw or Cygwin executor then we need to alias __main to orc_rt_int_void_return_0.
         if (jit_->getTargetTriple().isOSCygMing()) {
@@ -250,6 +373,27 @@ void LLVMCodeGen::configure() {
     }
 }
 
+// Returns the options of profile-guided optimization. Modules are either instrumented to write a raw profile, which is
+// merged into an indexed profile by `llvm-profdata`, or they are optimized using such an indexed profile. In both
+// cases, the optimization pipelines of the pass builder insert the required passes.
+std::optional<PGOOptions> LLVMCodeGen::getPGOOptions() const {
+    const auto file = config_.getProfileFile();
+    if (file.empty()) {
+        return std::nullopt;
+    }
+#ifdef _LLVM_LEGACY
+    logger_.error(string(), "linked LLVM version does not support profile-guided optimization.");
+    return std::nullopt;
+#else
+    const auto action = config_.hasFlag(Flag::PROFILE_GENERATE) ? PGOOptions::IRInstr : PGOOptions::IRUse;
+#ifdef _LLVM_16
+    return PGOOptions(file, "", "", action);
+#else
+    return PGOOptions(file, "", "", "", vfs::getRealFileSystem(), action);
+#endif
+#endif
+}
+
 std::string LLVMCodeGen::getLibName(const std::string &name, const bool dylib, const Triple &triple) {
     std::stringstream ss;
     if (triple.isOSCygMing()) {
@@ -292,8 +436,17 @@ void LLVMCodeGen::loadObjects(const ASTContext *ast) const {
             if (auto ec = buffer.getError()) {
                 logger_.error(file, ec.message());
             }
-            // Add the object file to the JIT
-            if (auto error = jit_->addObjectFile(std::move(buffer.get()))) {
+            // Add the object file to the JIT, the object file of a module whose code has been generated in
+            // partitions is an archive, see `emitPartitions`
+            if (identify_magic(buffer.get()->getBuffer()) == file_magic::archive) {
+                auto generator = orc::StaticLibraryDefinitionGenerator::Create(jit_->getObjLinkingLayer(),
+                                                                               std::move(buffer.get()));
+                if (generator) {
+                    jit_->getMainJITDylib().addGenerator(std::move(generator.get()));
+                } else {
+                    logger_.error(file, toString(generator.takeError()));
+                }
+            } else if (auto error = jit_->addObjectFile(std::move(buffer.get()))) {
                 logger_.error(file, toString(std::move(error)));
             }
             logger_.debug("Object file loaded: '" + file + "'.");
@@ -316,34 +469,40 @@ void LLVMCodeGen::generate(ASTContext *ast, const path path) {
     // Generate LLVM intermediate representation
     auto builder = std::make_unique<LLVMIRBuilder>(config_, ctx_, module.get());
     builder->build(ast);
+    optimize(*module);
+    if (module && logger_.getErrorCount() == 0) {
+        logger_.debug("Emitting code...");
+        emit(module.get(), path, type_);
+    } else {
+        logger_.error(path.filename().string(), "code generation failed.");
+    }
+}
+
+void LLVMCodeGen::optimize(Module &module) {
     logger_.debug("Analyzing...");
-    // Create basic analyses
-    LoopAnalysisManager lam;
-    FunctionAnalysisManager fam;
-    CGSCCAnalysisManager cgam;
-    ModuleAnalysisManager mam;
-    // Create a new pass manager builder
-    PassBuilder pb;
-    // Register all the basic analyses with the managers
-    pb.registerModuleAnalyses(mam);
-    pb.registerCGSCCAnalyses(cgam);
-    pb.registerFunctionAnalyses(fam);
-    pb.registerLoopAnalyses(lam);
-    pb.crossRegisterProxies(lam, fam, cgam, mam);
+    // The pass builder and the analysis managers are set up once per target
+    auto &pb = target_->pb;
+    auto &mam = target_->mam;
     ModulePassManager mpm;
     if (lvl_ == llvm::OptimizationLevel::O0) {
-        mpm = pb.buildO0DefaultPipeline(lvl_);
+#if defined(_LLVM_20) || defined(_LLVM_21) || defined(_LLVM_22)
+        mpm = pb.buildO0DefaultPipeline(lvl_, isLTO() ? ThinOrFullLTOPhase::ThinLTOPreLink : ThinOrFullLTOPhase::None);
+#else
+        mpm = pb.buildO0DefaultPipeline(lvl_, isLTO());
+#endif
+    } else if (isLTO()) {
+        // Inlining across modules is left to the link step, the pre-link pipeline keeps the IR amenable to it
+        mpm = pb.buildThinLTOPreLinkDefaultPipeline(lvl_);
     } else {
         mpm = pb.buildPerModuleDefaultPipeline(lvl_);
     }
     logger_.debug("Optimizing...");
-    mpm.run(*module, mam);
-    if (module && logger_.getErrorCount() == 0) {
-        logger_.debug("Emitting code...");
-        emit(module.get(), path, type_);
-    } else {
-        logger_.error(path.filename().string(), "code generation failed.");
-    }
+    mpm.run(module, mam);
+    // Discard the analysis results of this module, as the managers are reused for the next module
+    target_->lam.clear();
+    target_->fam.clear();
+    target_->cgam.clear();
+    mam.clear();
 }
 
 #ifndef _LLVM_LEGACY
@@ -364,10 +523,17 @@ int LLVMCodeGen::jit(ASTContext *ast, const path path) {
     // Generate LLVM intermediate representation
     const auto builder = std::make_unique<LLVMIRBuilder>(config_, *context, module.get());
     builder->build(ast);
-    // TODO run optimizer?
     if (module && logger_.getErrorCount() == 0) {
-        logger_.debug("Running JIT...");
-        exitOnErr_(jit_->addIRModule(orc::ThreadSafeModule(std::move(module), std::move(context))));
+        const auto start = std::chrono::steady_clock::now();
+        if (tiered_) {
+            // Procedures are compiled on first call and optimized once they are hot
+            logger_.debug("Running tiered JIT...");
+            exitOnErr_(tiered_->add(orc::ThreadSafeModule(std::move(module), std::move(context))));
+        } else {
+            optimize(*module);
+            logger_.debug("Running JIT...");
+            exitOnErr_(jit_->addIRModule(orc::ThreadSafeModule(std::move(module), std::move(context))));
+        }
         // Link with other imported modules (*.o and *.obj files)
         loadObjects(ast);
         // Register signal handler for Oberon traps
@@ -376,8 +542,16 @@ int LLVMCodeGen::jit(ASTContext *ast, const path path) {
         const string entry = ast->getTranslationUnit()->getIdentifier()->name();
         const auto mainAddr = exitOnErr_(jit_->lookup(entry));
         const auto mainFn = mainAddr.toPtr<int()>();
+        const auto entered = std::chrono::steady_clock::now();
         const int result = mainFn();
+        const auto finished = std::chrono::steady_clock::now();
         logger_.debug("Process finished with exit code " + to_string(result));
+        logger_.debug("Program started after " + to_string(millis(start, entered)) + " ms and ran for " +
+                      to_string(millis(entered, finished)) + " ms.");
+        if (tiered_) {
+            tiered_->stop();
+            logger_.debug("Tiered JIT: " + tiered_->getStatistics() + ".");
+        }
         return result;
     }
     logger_.error(path.filename().string(), "code generation failed.");
@@ -385,7 +559,16 @@ int LLVMCodeGen::jit(ASTContext *ast, const path path) {
 }
 #endif
 
-void LLVMCodeGen::emit(Module *module, path path, OutputFileType type) const {
+bool LLVMCodeGen::isLTO() const {
+    return config_.hasFlag(Flag::LTO) &&
+           (type_ == OutputFileType::ObjectFile || type_ == OutputFileType::ExecutableFile);
+}
+
+path LLVMCodeGen::getOutputFile(const path &file) const {
+    return getOutputName(file, type_);
+}
+
+std::string LLVMCodeGen::getOutputName(path path, const OutputFileType type) const {
     std::string ext;
     switch (type) {
         case OutputFileType::AssemblyFile:
@@ -405,10 +588,21 @@ void LLVMCodeGen::emit(Module *module, path path, OutputFileType type) const {
 #endif
             break;
     }
-    std::string name = config_.getOutputFile();
+    // When linking, the name of the output file is the name of the executable
+    std::string name = type == OutputFileType::ExecutableFile ? string() : config_.getOutputFile();
     if (name.empty()) {
         name = path.replace_extension(ext).string();
     }
+    return name;
+}
+
+void LLVMCodeGen::emit(Module *module, path path, OutputFileType type) const {
+    const auto name = getOutputName(path, type);
+    if (config_.getPartitions() > 1 && !isLTO() &&
+        (type == OutputFileType::ObjectFile || type == OutputFileType::ExecutableFile)) {
+        emitPartitions(module, path, name);
+        return;
+    }
     std::error_code ec;
     raw_fd_ostream output(name, ec, sys::fs::OF_None);
     if (ec) {
@@ -425,6 +619,14 @@ void LLVMCodeGen::emit(Module *module, path path, OutputFileType type) const {
         output.flush();
         return;
     }
+    if (isLTO()) {
+        // The object file is a bitcode file with a thin-LTO summary, which lets the linker import procedures of
+        // other modules without loading them entirely and optimize all modules in parallel
+        const auto index = buildModuleSummaryIndex(*module, nullptr, nullptr);
+        WriteBitcodeToFile(*module, output, false, &index);
+        output.flush();
+        return;
+    }
     CodeGenFileType ft;
     switch (type) {
         case OutputFileType::AssemblyFile:
@@ -450,3 +652,112 @@ void LLVMCodeGen::emit(Module *module, path path, OutputFileType type) const {
     pass.run(*module);
     output.flush();
 }
+
+// Makes the definitions that are local to the module visible, so that they can be referenced from other partitions of
+// the module. The definitions are qualified with the name of the module to keep them apart from those of other modules.
+static void qualifyLocals(Module &module) {
+    const auto prefix = module.getName().str() + ".";
+    unsigned anonymous = 0;
+    for (auto &gv : module.global_values()) {
+        if (gv.isDeclaration()) {
+            continue;
+        }
+        if (!gv.hasName()) {
+            gv.setName(prefix + "anon." + std::to_string(anonymous++));
+        } else if (gv.hasLocalLinkage()) {
+            gv.setName(prefix + gv.getName());
+        }
+        if (gv.hasLocalLinkage()) {
+            gv.setLinkage(GlobalValue::ExternalLinkage);
+            gv.setVisibility(GlobalValue::HiddenVisibility);
+        }
+    }
+}
+
+// Splits the optimized module into partitions of procedures and global variables, see `SplitModule`, and generates the
+// code of the partitions in parallel, using at most as many threads as there are hardware threads. The object file is
+// an archive with an object file for each partition, which is accepted by the linker and by the JIT in place of a single
+// object file.
+void LLVMCodeGen::emitPartitions(Module *module, const path &path, const string &name) const {
+    const auto count = config_.getPartitions();
+    auto threads = std::thread::hardware_concurrency();
+    threads = threads == 0 ? 1 : std::min(threads, count);
+    logger_.debug("Emitting code in " + to_string(count) + " partitions using " + to_string(threads) + " thread(s)...");
+    qualifyLocals(*module);
+    // Every partition is passed to its thread as bitcode, as the threads cannot share the context of the module
+    vector<SmallVector<char, 0>> bitcodes;
+    SplitModule(*module, count, [&bitcodes](unique_ptr<Module> part) {
+        bitcodes.emplace_back();
+        raw_svector_ostream output(bitcodes.back());
+        WriteBitcodeToFile(*part, output);
+    });
+    vector<SmallVector<char, 0>> buffers(bitcodes.size());
+    vector<string> errors;
+    std::mutex lock;
+    ::ThreadPool pool(threads);
+    for (size_t i = 0; i < bitcodes.size(); ++i) {
+        pool.submit([this, i, &bitcodes, &buffers, &errors, &lock] {
+            LLVMContext context;
+            auto part = parseBitcodeFile(MemoryBufferRef(StringRef(bitcodes[i].data(), bitcodes[i].size()),
+                                                         "partition." + to_string(i)), context);
+            if (!part) {
+                std::lock_guard guard(lock);
+                errors.push_back(toString(part.takeError()));
+                return;
+            }
+            // Every thread needs a target machine of its own
+            const unique_ptr<TargetMachine> tm(tm_->getTarget().createTargetMachine(
+#if defined(_LLVM_21) || defined(_LLVM_22)
+                    tm_->getTargetTriple(),
+#else
+                    tm_->getTargetTriple().getTriple(),
+#endif
+                    tm_->getTargetCPU(), tm_->getTargetFeatureString(), tm_->Options, tm_->getRelocationModel(),
+                    tm_->getCodeModel(), tm_->getOptLevel()));
+            raw_svector_ostream output(buffers[i]);
+            legacy::PassManager pass;
+#if defined(_LLVM_18) || defined(_LLVM_19)  || defined(_LLVM_20) || defined(_LLVM_21) || defined(_LLVM_22)
+            const auto ft = CodeGenFileType::ObjectFile;
+#else
+            const auto ft = CodeGenFileType::CGFT_ObjectFile;
+#endif
+            if (tm->addPassesToEmitFile(pass, output, nullptr, ft)) {
+                std::lock_guard guard(lock);
+                errors.emplace_back("target machine cannot emit a file of this type.");
+                return;
+            }
+            pass.run(*part.get());
+        });
+    }
+    pool.wait();
+    for (const auto &error : errors) {
+        logger_.error(path.string(), error);
+    }
+    if (!errors.empty()) {
+        return;
+    }
+    const auto stem = std::filesystem::path(name).stem().string();
+    const auto &triple = tm_->getTargetTriple();
+    vector<string> names;
+    vector<NewArchiveMember> members;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        names.push_back(getObjName(stem + "." + to_string(i), triple));
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        members.emplace_back(MemoryBufferRef(StringRef(buffers[i].data(), buffers[i].size()), names[i]));
+    }
+    object::Archive::Kind kind = object::Archive::K_GNU;
+    if (triple.isOSDarwin()) {
+        kind = object::Archive::K_DARWIN;
+    } else if (triple.isOSWindows() && !triple.isOSCygMing()) {
+        kind = object::Archive::K_COFF;
+    }
+#if defined(_LLVM_LEGACY) || defined(_LLVM_16)
+    auto err = writeArchive(name, members, true, kind, true, false);
+#else
+    auto err = writeArchive(name, members, SymtabWritingMode::NormalSymtab, kind, true, false);
+#endif
+    if (err) {
+        logger_.error(path.string(), toString(std::move(err)));
+    }
+}
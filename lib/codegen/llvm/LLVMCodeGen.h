@@ -9,6 +9,8 @@
 
 
 #include <csignal>
+#include <memory>
+#include <optional>
 #include <string>
 #include <filesystem>
 
@@ -21,6 +23,7 @@
 #include "Logger.h"
 #include "data/ast/ASTContext.h"
 #include "codegen/CodeGen.h"
+#include "LLVMTieredJIT.h"
 
 #ifdef _WINAPI
 #include <windows.h>
@@ -44,18 +47,36 @@ void register_signal_handler();
 
 using std::filesystem::path;
 using std::string;
+using std::unique_ptr;
+
+// Target machine and pass builder of a code generator. As both are costly to set up, they are kept in a process-wide
+// pool once a code generator is done and reused by the next code generator with the same target configuration, e.g.,
+// by the next request of the compile server. The options of profile-guided optimization are fixed when the pass
+// builder is set up and are therefore part of the target configuration.
+struct LLVMCodeGenTarget {
+    explicit LLVMCodeGenTarget(string key, llvm::TargetMachine *tm, const std::optional<llvm::PGOOptions> &pgo);
+
+    string key;
+    unique_ptr<llvm::TargetMachine> tm;
+    llvm::PassBuilder pb;
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+};
 
 class LLVMCodeGen final : public CodeGen {
 
 public:
     explicit LLVMCodeGen(CompilerConfig &);
-    ~LLVMCodeGen() override = default;
+    ~LLVMCodeGen() override;
 
     [[nodiscard]] std::string getDescription() override;
 
     void configure() override;
 
     void generate(ASTContext *, path) override;
+    [[nodiscard]] path getOutputFile(const path &) const override;
 #ifndef _LLVM_LEGACY
     int jit(ASTContext *, path) override;
 #endif
@@ -67,10 +88,18 @@ private:
     llvm::LLVMContext ctx_;
     llvm::OptimizationLevel lvl_;
     llvm::TargetMachine *tm_;
+    unique_ptr<LLVMCodeGenTarget> target_;
     std::unique_ptr<llvm::orc::LLJIT> jit_;
+    // Must be destroyed before the JIT, as it stops the thread that recompiles procedures
+    unique_ptr<LLVMTieredJIT> tiered_;
     llvm::ExitOnError exitOnErr_;
 
+    [[nodiscard]] bool isLTO() const;
+    void optimize(llvm::Module &);
+    [[nodiscard]] std::optional<llvm::PGOOptions> getPGOOptions() const;
     void emit(llvm::Module *, path, OutputFileType) const;
+    void emitPartitions(llvm::Module *, const path &, const string &) const;
+    [[nodiscard]] std::string getOutputName(path, OutputFileType) const;
     static std::string getLibName(const string &, bool, const llvm::Triple &);
     static std::string getObjName(const string &, const llvm::Triple &);
 
@@ -31,7 +31,11 @@ LLVMIRBuilder::LLVMIRBuilder(CompilerConfig &config, LLVMContext &builder, Modul
         attrs_.addAttribute(Attribute::StackProtect);
     }
 #endif
-    recordTdTy_ = StructType::create(builder_.getContext(), {builder_.getPtrTy(), builder_.getInt32Ty()});
+    // Type descriptor: display of the type ids of the first extension levels padded with nil, type ids of all
+    // extension levels, and extension level
+    recordTdTy_ = StructType::create(builder_.getContext(),
+                                     {ArrayType::get(builder_.getPtrTy(), TD_DISPLAY_SIZE), builder_.getPtrTy(),
+                                      builder_.getInt32Ty()});
     recordTdTy_->setName("record.record_td");
 }
 
@@ -88,6 +92,11 @@ void LLVMIRBuilder::visit(ModuleNode &node) {
     auto entry = BasicBlock::Create(builder_.getContext(), "entry", function_);
     builder_.SetInsertPoint(entry);
     scope_ = node.getScope() + 1;
+    // Register the shadow stack and the global variables as roots of the garbage collector.
+    if (config_.hasFlag(Flag::GARBAGE_COLLECT)) {
+        function_->setGC("shadow-stack");
+        createGCRoots(node);
+    }
     // Generate code to initialize imports.
     for (const auto &import : node.imports()) {
         import->accept(*this);
@@ -144,6 +153,10 @@ void LLVMIRBuilder::visit(ProcedureDefinitionNode &node) {
     const auto entry = BasicBlock::Create(builder_.getContext(), "entry", function_);
     builder_.SetInsertPoint(entry);
     const auto layout = module_->getDataLayout();
+    const bool gc = config_.hasFlag(Flag::GARBAGE_COLLECT);
+    if (gc) {
+        function_->setGC("shadow-stack");
+    }
     // Allocate space for parameters.
     Function::arg_iterator args = function_->arg_begin();
     for (auto &param : node.getType()->parameters()) {
@@ -156,6 +169,9 @@ void LLVMIRBuilder::visit(ProcedureDefinitionNode &node) {
         alloc->setAlignment(layout.getABITypeAlign(paramTy));
         builder_.CreateStore(arg, alloc);
         values_[param.get()] = alloc;
+        if (gc && !param->isVar() && type->isPointer()) {
+            createGCRoot(alloc, type);
+        }
         if (type->isArray() && dynamic_cast<ArrayTypeNode*>(type)->isOpen()) {
             // Handle the parameter containing the dope vector of an open array.
             arg = args++;
@@ -183,8 +199,8 @@ void LLVMIRBuilder::visit(ProcedureDefinitionNode &node) {
             // Cache the dope vector of the variable type
             valueDopes_[variable] = typeDopes_[dynamic_cast<ArrayTypeNode*>(type)];
         }
-        // Zero initialization of local variables
-        if (config_.hasFlag(Flag::INIT_LOCAL_ZERO)) {
+        // Zero initialization of local variables, which is required for variables that are roots of the collector
+        if (config_.hasFlag(Flag::INIT_LOCAL_ZERO) || (gc && hasPointers(type))) {
             if (type->isStructured()) {
                 const auto size = layout.getTypeAllocSize(varTy);
                 builder_.CreateMemSet(alloc, builder_.getInt8(0), builder_.getInt64(size), align);
@@ -193,6 +209,9 @@ void LLVMIRBuilder::visit(ProcedureDefinitionNode &node) {
                 builder_.CreateStore(nil, alloc);
             }
         }
+        if (gc) {
+            createGCRoot(alloc, type);
+        }
     }
     // Generate code for statement sequence
     scope_ = node.getScope() + 1;
@@ -407,6 +426,9 @@ TypeNode *LLVMIRBuilder::selectors(const NodeReference *ref, TypeNode *base, con
             value = builder_.CreateCall(dyn_cast<FunctionType>(funTy), value, values);
             decl = nullptr;
             selector_t = procedure_t->getReturnType();
+            if (selector_t && selector_t->isPointer() && config_.hasFlag(Flag::GARBAGE_COLLECT)) {
+                createGCTemporary(value);
+            }
             baseTy = getLLVMType(selector_t);
         } else if (sel->getNodeType() == NodeType::array_type) {
             const auto array = dynamic_cast<ArrayIndex *>(sel);
@@ -429,7 +451,8 @@ TypeNode *LLVMIRBuilder::selectors(const NodeReference *ref, TypeNode *base, con
                 index->accept(*this);
                 restoreRefMode();
                 // Create an out-of-bounds check and trap for the current array index.
-                if (config_.isSanitized(Trap::OUT_OF_BOUNDS) && (array_t->isOpen() || !index->isLiteral())) {
+                if (config_.isSanitized(Trap::OUT_OF_BOUNDS) && (array_t->isOpen() || !index->isLiteral()) &&
+                    isBoundsChecked(array, i)) {
                     Value *lower = builder_.getInt64(0);
                     Value *upper = getOrLoadArrayLength(lengths, dopeV, array_t, static_cast<uint32_t>(i));
                     trapOutOfBounds(builder_.CreateSExt(value_, builder_.getInt64Ty()), lower, upper);
@@ -606,6 +629,10 @@ TypeNode *LLVMIRBuilder::createStaticCall(NodeReference &node, const QualIdent *
     } else {
         if (const auto fun = module_->getFunction(qualifiedName(proc))) {
             value_ = builder_.CreateCall(fun, values);
+            const auto ret_t = proc->getType()->getReturnType();
+            if (ret_t && ret_t->isPointer() && config_.hasFlag(Flag::GARBAGE_COLLECT)) {
+                createGCTemporary(value_);
+            }
         } else {
             logger_.error(ident->start(), "undefined procedure: " + to_string(*ident) + " [" + qualifiedName(proc) + "].");
         }
@@ -726,6 +753,10 @@ void LLVMIRBuilder::trapAssert(Value *cond) {
 }
 
 Value *LLVMIRBuilder::trapIntOverflow(const Intrinsic::ID intrinsic, Value *lhs, Value *rhs) {
+    if (!overflows_.empty() && overflows_.top()) {
+        // Only the checks directly in the body of a loop with a flag are deferred, not those of a nested loop
+        return deferIntOverflow(intrinsic, lhs, rhs);
+    }
     const auto type = dyn_cast<IntegerType>(rhs->getType());
 #if defined(_LLVM_20) || defined(_LLVM_21) || defined(_LLVM_22)
     Function* fun = Intrinsic::getOrInsertDeclaration(module_, intrinsic, { type });
@@ -740,6 +771,34 @@ Value *LLVMIRBuilder::trapIntOverflow(const Intrinsic::ID intrinsic, Value *lhs,
     return result;
 }
 
+Value *LLVMIRBuilder::deferIntOverflow(const Intrinsic::ID intrinsic, Value *lhs, Value *rhs) {
+    // The overflow is computed without the overflow intrinsics and accumulated in the flag of the enclosing loop,
+    // so that the loop has no branches other than its back edge and can be vectorized.
+    const auto type = dyn_cast<IntegerType>(rhs->getType());
+    const auto zero = ConstantInt::get(type, 0);
+    Value *result, *status;
+    if (intrinsic == Intrinsic::sadd_with_overflow) {
+        // The operands have the same sign, which differs from the sign of the result
+        result = builder_.CreateAdd(lhs, rhs);
+        const auto sign = builder_.CreateAnd(builder_.CreateXor(lhs, result), builder_.CreateXor(rhs, result));
+        status = builder_.CreateICmpSLT(sign, zero);
+    } else if (intrinsic == Intrinsic::ssub_with_overflow) {
+        // The operands have different signs and the sign of the result differs from the sign of the minuend
+        result = builder_.CreateSub(lhs, rhs);
+        const auto sign = builder_.CreateAnd(builder_.CreateXor(lhs, rhs), builder_.CreateXor(lhs, result));
+        status = builder_.CreateICmpSLT(sign, zero);
+    } else {
+        // The product in twice the width is not representable in the width of the operands
+        const auto wide = builder_.getIntNTy(type->getBitWidth() * 2);
+        const auto product = builder_.CreateMul(builder_.CreateSExt(lhs, wide), builder_.CreateSExt(rhs, wide));
+        result = builder_.CreateTrunc(product, type);
+        status = builder_.CreateICmpNE(builder_.CreateSExt(result, wide), product);
+    }
+    const auto flag = overflows_.top();
+    builder_.CreateStore(builder_.CreateOr(builder_.CreateLoad(builder_.getInt1Ty(), flag), status), flag);
+    return result;
+}
+
 void LLVMIRBuilder::trapFltDivByZero(Value *divisor) {
     const auto cond = builder_.CreateFCmpUNE(divisor, ConstantFP::get(divisor->getType(), 0));
     installTrap(cond, static_cast<uint8_t>(Trap::FLT_DIVISION));
@@ -767,9 +826,13 @@ Value *LLVMIRBuilder::createTypeTest(Value *td, TypeNode *type) {
         const auto pointer_t = dynamic_cast<PointerTypeNode *>(type);
         record_t = dynamic_cast<RecordTypeNode *>(pointer_t->getBase());
     }
-    Value *level = builder_.getInt32(record_t->getLevel());
     Value *value = builder_.CreateLoad(builder_.getPtrTy(), td);
-    auto len = builder_.CreateInBoundsGEP(recordTdTy_, value, {builder_.getInt32(0), builder_.getInt32(1)});
+    if (record_t->getLevel() < TD_DISPLAY_SIZE) {
+        return createDisplayTest(value, record_t);
+    }
+    // Type tests of deeply extended types check the extension level before looking up the type id
+    Value *level = builder_.getInt32(record_t->getLevel());
+    auto len = builder_.CreateInBoundsGEP(recordTdTy_, value, {builder_.getInt32(0), builder_.getInt32(TD_LEVEL)});
     len = builder_.CreateLoad(builder_.getInt32Ty(), len);
     auto cond = builder_.CreateICmpULE(level, len);
     const auto cur = builder_.GetInsertBlock();
@@ -777,7 +840,7 @@ Value *LLVMIRBuilder::createTypeTest(Value *td, TypeNode *type) {
     const auto skip = BasicBlock::Create(builder_.getContext(), "skip", function_);
     builder_.CreateCondBr(cond, test, skip);
     builder_.SetInsertPoint(test);
-    const auto ids = builder_.CreateInBoundsGEP(recordTdTy_, value, {builder_.getInt32(0), builder_.getInt32(0)});
+    const auto ids = builder_.CreateInBoundsGEP(recordTdTy_, value, {builder_.getInt32(0), builder_.getInt32(TD_IDS)});
     value = builder_.CreateLoad(builder_.getPtrTy(), ids);
     const auto id = builder_.CreateInBoundsGEP(builder_.getPtrTy(), value, {level});
     value = builder_.CreateLoad(builder_.getPtrTy(), id);
@@ -790,6 +853,14 @@ Value *LLVMIRBuilder::createTypeTest(Value *td, TypeNode *type) {
     return phi;
 }
 
+Value *LLVMIRBuilder::createDisplayTest(Value *td, RecordTypeNode *type) {
+    // As the display is padded with nil, the type id at the extension level of the type can be compared directly
+    const auto id = builder_.CreateInBoundsGEP(recordTdTy_, td, {builder_.getInt32(0), builder_.getInt32(TD_DISPLAY),
+                                                                 builder_.getInt32(type->getLevel())});
+    const auto value = builder_.CreateLoad(builder_.getPtrTy(), id);
+    return builder_.CreateICmpEQ(recTypeIds_[type], value);
+}
+
 Value *LLVMIRBuilder::createTypeTest(Value *value, const NodeReference *ref, const TypeNode *lType, TypeNode *rType) {
     const auto prv = builder_.GetInsertBlock();
     BasicBlock *skip = nullptr;
@@ -839,24 +910,103 @@ void LLVMIRBuilder::createTypeTestCase(const CaseOfNode &node, BasicBlock *dflt,
     const auto lhs = value_;
     const auto lExpr = dynamic_cast<QualifiedExpression *>(node.getExpression());
     const auto lType = lExpr->dereference()->getType();
+    if (lType->isPointer()) {
+        const auto test = BasicBlock::Create(builder_.getContext(), "dispatch", function_);
+        builder_.CreateCondBr(builder_.CreateIsNotNull(lhs), test, dflt);
+        builder_.SetInsertPoint(test);
+    }
+    // Compute the number of the first case whose label matches the dynamic type without branching and dispatch on
+    // it, the labels are tested in reverse order so that the first matching case takes precedence
+    Value *tdSlot = nullptr;
+    Value *td = nullptr;
+    Value *index = builder_.getInt32(0);
+    for (size_t i = node.getLabelCount(); i-- > 0;) {
+        const auto label = node.getCase(i)->getLabel()->getValue(0);
+        const auto rType = dynamic_cast<QualifiedExpression *>(label)->dereference()->getType();
+        Value *cond;
+        if (lType->extends(rType)) {
+            cond = builder_.getTrue();
+        } else {
+            if (!tdSlot) {
+                tdSlot = getTypeDescriptor(lhs, lExpr, rType);
+                td = builder_.CreateLoad(builder_.getPtrTy(), tdSlot);
+            }
+            auto *record_t = dynamic_cast<RecordTypeNode *>(rType);
+            if (!record_t) {
+                record_t = dynamic_cast<RecordTypeNode *>(dynamic_cast<PointerTypeNode *>(rType)->getBase());
+            }
+            cond = record_t->getLevel() < TD_DISPLAY_SIZE ? createDisplayTest(td, record_t) : createTypeTest(tdSlot, rType);
+        }
+        index = builder_.CreateSelect(cond, builder_.getInt32(static_cast<uint32_t>(i + 1)), index);
+    }
+    SwitchInst *inst = builder_.CreateSwitch(index, dflt, static_cast<unsigned int>(node.getLabelCount()));
     for (size_t i = 0; i < node.getLabelCount(); ++i) {
         const auto c = node.getCase(i);
-        const auto label = c->getLabel()->getValue(0);
-        const auto rExpr = dynamic_cast<QualifiedExpression *>(label);
+        const auto rExpr = dynamic_cast<QualifiedExpression *>(c->getLabel()->getValue(0));
         const auto rType = rExpr->dereference()->getType();
-        auto name = rType->getIdentifier()->name();
-        const auto is_true = BasicBlock::Create(builder_.getContext(), "is" + name + "_true", function_);
-        const auto is_false = BasicBlock::Create(builder_.getContext(), "is" + name + "_false", function_);
-        const auto cond = createTypeTest(lhs, lExpr, lType, rType);
-        builder_.CreateCondBr(cond, is_true, is_false);
-        builder_.SetInsertPoint(is_true);
+        const auto block = BasicBlock::Create(builder_.getContext(), "is" + rType->getIdentifier()->name(), function_);
+        builder_.SetInsertPoint(block);
         lExpr->dereference()->setType(rType);   // Set the formal type to the actual type
         c->getStatements()->accept(*this);
         ensureTerminator(tail);
         lExpr->dereference()->setType(lType);   // Reset the formal type of the case expression
-        builder_.SetInsertPoint(is_false);
+        inst->addCase(builder_.getInt32(static_cast<uint32_t>(i + 1)), block);
     }
-    builder_.CreateBr(dflt);
+}
+
+Value *LLVMIRBuilder::getStringLength(ExpressionNode *expr) {
+    if (expr->getType()->isArray()) {
+        return getArrayLength(expr, 0);
+    }
+    if (const auto str = dynamic_cast<StringLiteralNode *>(expr)) {
+        return builder_.getInt64(str->value().size() + 1);
+    }
+    // Other strings are constants and always terminated
+    return builder_.getInt64(static_cast<uint64_t>(std::numeric_limits<int64_t>::max()));
+}
+
+Value *LLVMIRBuilder::createInlineStringComparison(Value *lhs, const uint64_t lhsLen, Value *rhs, const uint64_t rhsLen) {
+    const auto len = std::min(lhsLen, rhsLen);
+    const auto prv = builder_.GetInsertBlock();
+    const auto loop = BasicBlock::Create(builder_.getContext(), "strcmp_loop", function_);
+    const auto check = BasicBlock::Create(builder_.getContext(), "strcmp_check", function_);
+    const auto next = BasicBlock::Create(builder_.getContext(), "strcmp_next", function_);
+    const auto end = BasicBlock::Create(builder_.getContext(), "strcmp_end", function_);
+    const auto tail = BasicBlock::Create(builder_.getContext(), "strcmp_tail", function_);
+    builder_.CreateBr(loop);
+    // Compare the characters at the current position
+    builder_.SetInsertPoint(loop);
+    const auto idx = builder_.CreatePHI(builder_.getInt64Ty(), 2);
+    idx->addIncoming(builder_.getInt64(0), prv);
+    const auto lch = builder_.CreateLoad(builder_.getInt8Ty(), builder_.CreateInBoundsGEP(builder_.getInt8Ty(), lhs, {idx}));
+    const auto rch = builder_.CreateLoad(builder_.getInt8Ty(), builder_.CreateInBoundsGEP(builder_.getInt8Ty(), rhs, {idx}));
+    const auto diff = builder_.CreateSub(builder_.CreateZExt(lch, builder_.getInt32Ty()),
+                                         builder_.CreateZExt(rch, builder_.getInt32Ty()));
+    builder_.CreateCondBr(builder_.CreateICmpNE(lch, rch), tail, check);
+    // Stop at the terminating 0X of both strings
+    builder_.SetInsertPoint(check);
+    builder_.CreateCondBr(builder_.CreateICmpEQ(lch, builder_.getInt8(0)), tail, next);
+    builder_.SetInsertPoint(next);
+    const auto inc = builder_.CreateAdd(idx, builder_.getInt64(1));
+    idx->addIncoming(inc, next);
+    builder_.CreateCondBr(builder_.CreateICmpULT(inc, builder_.getInt64(len)), loop, end);
+    // All characters of the shorter operand are equal, its end is compared as 0X with the longer operand
+    builder_.SetInsertPoint(end);
+    Value *rest = builder_.getInt32(0);
+    if (lhsLen < rhsLen) {
+        const auto ch = builder_.CreateLoad(builder_.getInt8Ty(), builder_.CreateInBoundsGEP(builder_.getInt8Ty(), rhs, {builder_.getInt64(len)}));
+        rest = builder_.CreateNeg(builder_.CreateZExt(ch, builder_.getInt32Ty()));
+    } else if (lhsLen > rhsLen) {
+        const auto ch = builder_.CreateLoad(builder_.getInt8Ty(), builder_.CreateInBoundsGEP(builder_.getInt8Ty(), lhs, {builder_.getInt64(len)}));
+        rest = builder_.CreateZExt(ch, builder_.getInt32Ty());
+    }
+    builder_.CreateBr(tail);
+    builder_.SetInsertPoint(tail);
+    const auto phi = builder_.CreatePHI(builder_.getInt32Ty(), 3);
+    phi->addIncoming(diff, loop);
+    phi->addIncoming(builder_.getInt32(0), check);
+    phi->addIncoming(rest, end);
+    return phi;
 }
 
 Value *LLVMIRBuilder::createStringComparison(const BinaryExpressionNode *node) {
@@ -876,16 +1026,31 @@ Value *LLVMIRBuilder::createStringComparison(const BinaryExpressionNode *node) {
     Value *value = nullptr;
     Value *test = builder_.getInt32(0);
     if ((lhsType->isArray() && rhsType->isArray()) || lhsType->isString() || rhsType->isString()) {
-        // TODO This introduces a dependency to `strcmp` that might not be ideal.
-        auto fun = module_->getFunction("strcmp");
-        if (!fun) {
-            const auto type = FunctionType::get(builder_.getInt32Ty(), {builder_.getPtrTy(), builder_.getPtrTy()}, false);
-            fun = Function::Create(type, GlobalValue::ExternalLinkage, "strcmp", module_);
-            // fun->addFnAttr(Attribute::getWithAllocSizeArgs(builder_.getContext(), 0, {}));
-            fun->addParamAttr(0, Attribute::NoUndef);
-            fun->addParamAttr(1, Attribute::NoUndef);
-        }
-        value = builder_.CreateCall(FunctionCallee(fun), {lhsValue, rhsValue});
+        // Characters are compared up to the terminating 0X or the end of the shorter operand, whichever comes first.
+        // Operands of short static length are compared inline, all others by the run-time library.
+        const auto lhsLen = getStringLength(lhs);
+        const auto rhsLen = getStringLength(rhs);
+        const auto lhsConst = dyn_cast<ConstantInt>(lhsLen);
+        const auto rhsConst = dyn_cast<ConstantInt>(rhsLen);
+        if (lhsConst && rhsConst &&
+            std::min(lhsConst->getZExtValue(), rhsConst->getZExtValue()) <= STRING_INLINE_LENGTH) {
+            value = createInlineStringComparison(lhsValue, lhsConst->getZExtValue(),
+                                                 rhsValue, rhsConst->getZExtValue());
+        } else {
+            auto fun = module_->getFunction("olang_rt_strcmp_n");
+            if (!fun) {
+                const auto type = FunctionType::get(builder_.getInt32Ty(),
+                                                    {builder_.getPtrTy(), builder_.getInt64Ty(),
+                                                     builder_.getPtrTy(), builder_.getInt64Ty()}, false);
+                fun = Function::Create(type, GlobalValue::ExternalLinkage, "olang_rt_strcmp_n", module_);
+                fun->addFnAttr(Attribute::NoUnwind);
+                fun->setOnlyReadsMemory();
+                for (unsigned i = 0; i < 4; ++i) {
+                    fun->addParamAttr(i, Attribute::NoUndef);
+                }
+            }
+            value = builder_.CreateCall(FunctionCallee(fun), {lhsValue, lhsLen, rhsValue, rhsLen});
+        }
     } else {
         value = lhsType->isChar() ? rhsValue : lhsValue;
         value = builder_.CreateInBoundsGEP(ArrayType::get(builder_.getInt8Ty(), 0), value,
@@ -1095,13 +1260,25 @@ void LLVMIRBuilder::visit(BinaryExpressionNode &node) {
         const bool floating = lhsType->isReal() || rhsType->isReal();
         switch (node.getOperator()) {
             case OperatorType::PLUS:
-                value_ = floating ? builder_.CreateFAdd(lhs, rhs) : createAdd(lhs, rhs);
+                if (floating) {
+                    value_ = builder_.CreateFAdd(lhs, rhs);
+                } else {
+                    value_ = node.canOverflow() ? createAdd(lhs, rhs) : builder_.CreateNSWAdd(lhs, rhs);
+                }
                 break;
             case OperatorType::MINUS:
-                value_ = floating ? builder_.CreateFSub(lhs, rhs) : createSub(lhs, rhs);
+                if (floating) {
+                    value_ = builder_.CreateFSub(lhs, rhs);
+                } else {
+                    value_ = node.canOverflow() ? createSub(lhs, rhs) : builder_.CreateNSWSub(lhs, rhs);
+                }
                 break;
             case OperatorType::TIMES:
-                value_ = floating ? builder_.CreateFMul(lhs, rhs) : createMul(lhs, rhs);
+                if (floating) {
+                    value_ = builder_.CreateFMul(lhs, rhs);
+                } else {
+                    value_ = node.canOverflow() ? createMul(lhs, rhs) : builder_.CreateNSWMul(lhs, rhs);
+                }
                 break;
             case OperatorType::DIVIDE:
                 value_ = createFDiv(lhs, rhs);
@@ -1303,8 +1480,13 @@ void LLVMIRBuilder::visit(RecordTypeNode &node) {
                 ConstantArray::get(idsType, typeIds), name + "_ids");
         ids->setAlignment(module_->getDataLayout().getABITypeAlign(idsType));
         // Create the type descriptor
+        vector<Constant *> display(typeIds.begin(), typeIds.begin() +
+                                   static_cast<long>(std::min<size_t>(typeIds.size(), TD_DISPLAY_SIZE)));
+        display.resize(TD_DISPLAY_SIZE, nil);
+        const auto displayType = ArrayType::get(builder_.getPtrTy(), TD_DISPLAY_SIZE);
         const auto td = new GlobalVariable(*module_, recordTdTy_, true, GlobalValue::ExternalLinkage,
-                ConstantStruct::get(recordTdTy_, {ids, ConstantInt::get(builder_.getInt32Ty(), node.getLevel())}),
+                ConstantStruct::get(recordTdTy_, {ConstantArray::get(displayType, display), ids,
+                                                  ConstantInt::get(builder_.getInt32Ty(), node.getLevel())}),
                 name + "_td");
         td->setAlignment(module_->getDataLayout().getABITypeAlign(recordTdTy_));
         recTypeTds_[&node] = td;
@@ -1408,9 +1590,9 @@ void LLVMIRBuilder::visit(AssignmentNode &node) {
                 if (const auto rhs = dynamic_cast<QualifiedExpression *>(node.getRvalue()); rhs->isVarParameter()) {
                     rhsTd = builder_.CreateLoad(builder_.getPtrTy(), valueTds_[rhs->dereference()]);
                     // Look up the dynamic size of the right-hand size
-                    auto pos = builder_.CreateInBoundsGEP(recordTdTy_, rhsTd, {builder_.getInt32(0), builder_.getInt32(1)});
+                    auto pos = builder_.CreateInBoundsGEP(recordTdTy_, rhsTd, {builder_.getInt32(0), builder_.getInt32(TD_LEVEL)});
                     pos = builder_.CreateLoad(builder_.getInt32Ty(), pos);
-                    const auto ids = builder_.CreateInBoundsGEP(recordTdTy_, rhsTd, {{builder_.getInt32(0), builder_.getInt32(0)}});
+                    const auto ids = builder_.CreateInBoundsGEP(recordTdTy_, rhsTd, {{builder_.getInt32(0), builder_.getInt32(TD_IDS)}});
                     Value *value = builder_.CreateLoad(builder_.getPtrTy(), ids);
                     const auto id = builder_.CreateInBoundsGEP(builder_.getPtrTy(), value, {pos});
                     value = builder_.CreateLoad(builder_.getPtrTy(), id);
@@ -1584,18 +1766,66 @@ void LLVMIRBuilder::visit(ForLoopNode &node) {
     const auto start = value_;
     restoreRefMode();
     node.getCounter()->accept(*this);
-    auto counter = value_;
+    const auto counter = value_;
     builder_.CreateStore(start, counter);
     // Check whether to skip loop body
     setRefMode(true);
     node.getHigh()->accept(*this);
-    auto end = value_;
+    const auto end = value_;
     restoreRefMode();
     const auto body = BasicBlock::Create(builder_.getContext(), "for_body", function_);
     const auto tail = BasicBlock::Create(builder_.getContext(), "for_tail", function_);
     const auto step = dynamic_cast<IntegerLiteralNode*>(node.getStep())->value();
     value_ = step > 0 ? builder_.CreateICmpSLE(start, end) : builder_.CreateICmpSGE(start, end);
-    builder_.CreateCondBr(value_, body, tail);
+    Value *overflow = nullptr;
+    if (config_.isSanitized(Trap::INT_OVERFLOW) && node.hasDeferredOverflow()) {
+        // The high bound is invariant, hence the counter cannot overflow if the high bound is not beyond the largest
+        // (smallest) value to which the step can be added.
+        const auto type = dyn_cast<IntegerType>(end->getType());
+        const auto bits = type->getBitWidth();
+        if (step > 0) {
+            const auto limit = ConstantInt::get(type, APInt::getSignedMaxValue(bits) - static_cast<uint64_t>(step));
+            installTrap(builder_.CreateNot(builder_.CreateAnd(value_, builder_.CreateICmpSGT(end, limit))),
+                        static_cast<uint8_t>(Trap::INT_OVERFLOW));
+        } else {
+            const auto limit = ConstantInt::get(type, APInt::getSignedMinValue(bits) + static_cast<uint64_t>(-step));
+            installTrap(builder_.CreateNot(builder_.CreateAnd(value_, builder_.CreateICmpSLT(end, limit))),
+                        static_cast<uint8_t>(Trap::INT_OVERFLOW));
+        }
+        // Flag that accumulates the overflows of the loop body until the loop is exited
+        auto &entry = function_->getEntryBlock();
+        IRBuilder<> builder(&entry, entry.getFirstInsertionPt());
+        overflow = builder.CreateAlloca(builder_.getInt1Ty(), nullptr, "for.ovf");
+        builder_.CreateStore(builder_.getFalse(), overflow);
+    }
+    // Loops without a flag push a null marker, so that the checks in their body trap immediately
+    overflows_.push(overflow);
+    if (config_.isSanitized(Trap::OUT_OF_BOUNDS) && !node.guards().empty()) {
+        // Check the bounds of the array indices guarded by the loop once: if they are all within bounds, the loop
+        // body is entered without checking them again, otherwise a copy of the loop body that checks them is entered.
+        const auto guard = BasicBlock::Create(builder_.getContext(), "for_guard", function_);
+        const auto checked = BasicBlock::Create(builder_.getContext(), "for_checked", function_);
+        builder_.CreateCondBr(value_, guard, tail);
+        builder_.SetInsertPoint(guard);
+        builder_.CreateCondBr(createLoopGuard(node, start, end, step), body, checked);
+        guarded_.insert(&node);
+        createForLoop(node, body, tail, step);
+        guarded_.erase(&node);
+        createForLoop(node, checked, tail, step);
+    } else {
+        builder_.CreateCondBr(value_, body, tail);
+        createForLoop(node, body, tail, step);
+    }
+    // After loop
+    builder_.SetInsertPoint(tail);
+    overflows_.pop();
+    if (overflow) {
+        const auto cond = builder_.CreateNot(builder_.CreateLoad(builder_.getInt1Ty(), overflow));
+        installTrap(cond, static_cast<uint8_t>(Trap::INT_OVERFLOW));
+    }
+}
+
+void LLVMIRBuilder::createForLoop(ForLoopNode &node, BasicBlock *body, BasicBlock *tail, const int64_t step) {
     // Loop body
     builder_.SetInsertPoint(body);
     loopTails_.push(tail);
@@ -1606,14 +1836,17 @@ void LLVMIRBuilder::visit(ForLoopNode &node) {
         setRefMode(true);
         node.getCounter()->accept(*this);
         restoreRefMode();
-        counter = builder_.CreateAdd(value_, ConstantInt::getSigned(value_->getType(), step));
+        const auto delta = ConstantInt::getSigned(value_->getType(), step);
+        // The counter of a loop whose overflow checks are deferred has been checked before the loop is entered
+        const bool checked = config_.isSanitized(Trap::INT_OVERFLOW) && node.hasDeferredOverflow();
+        auto counter = checked ? builder_.CreateNSWAdd(value_, delta) : builder_.CreateAdd(value_, delta);
         node.getCounter()->accept(*this);
         const auto lValue = value_;
         builder_.CreateStore(counter, lValue);
         // Check whether to exit loop body
         setRefMode(true);
         node.getHigh()->accept(*this);
-        end = value_;
+        const auto end = value_;
         node.getCounter()->accept(*this);
         counter = value_;
         restoreRefMode();
@@ -1624,8 +1857,47 @@ void LLVMIRBuilder::visit(ForLoopNode &node) {
         }
         builder_.CreateCondBr(value_, tail, body);
     }
-    // After loop
-    builder_.SetInsertPoint(tail);
+}
+
+Value *LLVMIRBuilder::createLoopGuard(ForLoopNode &node, Value *start, Value *end, const int64_t step) {
+    // The counter ranges from the low to the high bound when counting up, and from the high to the low bound
+    // when counting down.
+    const auto from = builder_.CreateSExt(step > 0 ? start : end, builder_.getInt64Ty());
+    const auto to = builder_.CreateSExt(step > 0 ? end : start, builder_.getInt64Ty());
+    Value *cond = builder_.getTrue();
+    for (const auto &guard : node.guards()) {
+        Value *lower = builder_.getInt64(0);
+        Value *upper = lower;
+        if (guard.index && guard.index->dereference() == node.getCounter()->dereference()) {
+            lower = from;
+            upper = to;
+        } else if (guard.index) {
+            setRefMode(true);
+            guard.index->accept(*this);
+            restoreRefMode();
+            lower = upper = builder_.CreateSExt(value_, builder_.getInt64Ty());
+        }
+        Value *dopeV = guard.array->isOpen() ? valueDopes_[guard.decl] : nullptr;
+        vector<Value *> lengths(guard.array->dimensions(), nullptr);
+        Value *length = getOrLoadArrayLength(lengths, dopeV, guard.array, guard.dimension);
+        // The offsets are applied to the constants, so that the comparisons cannot overflow.
+        const auto type = builder_.getInt64Ty();
+        cond = builder_.CreateAnd(cond, builder_.CreateICmpSGE(lower, ConstantInt::getSigned(type, -guard.lower)));
+        length = builder_.CreateSub(length, ConstantInt::getSigned(type, guard.upper));
+        cond = builder_.CreateAnd(cond, builder_.CreateICmpSLT(upper, length));
+    }
+    return cond;
+}
+
+bool LLVMIRBuilder::isBoundsChecked(const ArrayIndex *array, const size_t index) const {
+    switch (array->getCheck(index)) {
+        case BoundsCheck::REDUNDANT:
+            return false;
+        case BoundsCheck::GUARDED:
+            return !guarded_.contains(array->getGuard(index));
+        default:
+            return true;
+    }
 }
 
 void LLVMIRBuilder::visit(ReturnNode &node) {
@@ -1888,7 +2160,11 @@ LLVMIRBuilder::createExclCall(Value *set, Value *element) {
 
 Value *
 LLVMIRBuilder::createDisposeCall([[maybe_unused]] TypeNode *type, Value *param) {
-    auto fun = module_->getFunction("free");
+    string name = config_.hasFlag(Flag::POOL_ALLOCATOR) ? "olang_rt_free" : "free";
+    if (config_.hasFlag(Flag::GARBAGE_COLLECT)) {
+        name = "olang_gc_free";
+    }
+    auto fun = module_->getFunction(name);
 #ifdef _LLVM_LEGACY
     auto voidTy = PointerType::get(builder_.getVoidTy(), 0);
 #else
@@ -1896,7 +2172,7 @@ LLVMIRBuilder::createDisposeCall([[maybe_unused]] TypeNode *type, Value *param)
 #endif
     if (!fun) {
         auto funTy = FunctionType::get(builder_.getVoidTy(), {voidTy}, false);
-        fun = Function::Create(funTy, GlobalValue::ExternalLinkage, "free", module_);
+        fun = Function::Create(funTy, GlobalValue::ExternalLinkage, name, module_);
         fun->addParamAttr(0, Attribute::NoUndef);
     }
     std::vector<Value *> values;
@@ -2080,10 +2356,21 @@ LLVMIRBuilder::createMaxMinCall(ExpressionNode *actual, const bool isMax) {
 
 Value *
 LLVMIRBuilder::createNewCall(TypeNode *type, Value *param) {
-    auto fun = module_->getFunction("malloc");
+    // The collector additionally needs the pointer map of the block, the pool allocator of the run-time library
+    // serves the statically known size from a size-class free list
+    const bool collect = config_.hasFlag(Flag::GARBAGE_COLLECT);
+    string name = config_.hasFlag(Flag::POOL_ALLOCATOR) ? "olang_rt_alloc" : "malloc";
+    if (collect) {
+        name = "olang_gc_alloc";
+    }
+    auto fun = module_->getFunction(name);
     if (!fun) {
-        const auto funTy = FunctionType::get(builder_.getPtrTy(), { builder_.getInt64Ty() }, false);
-        fun = Function::Create(funTy, GlobalValue::ExternalLinkage, "malloc", module_);
+        std::vector<Type *> params = { builder_.getInt64Ty() };
+        if (collect) {
+            params.push_back(builder_.getPtrTy());
+        }
+        const auto funTy = FunctionType::get(builder_.getPtrTy(), params, false);
+        fun = Function::Create(funTy, GlobalValue::ExternalLinkage, name, module_);
         fun->addFnAttr(Attribute::getWithAllocSizeArgs(builder_.getContext(), 0, {}));
         fun->addParamAttr(0, Attribute::NoUndef);
     }
@@ -2097,6 +2384,9 @@ LLVMIRBuilder::createNewCall(TypeNode *type, Value *param) {
     } else {
         values.push_back(ConstantInt::get(builder_.getInt64Ty(), layout.getTypeAllocSize(getLLVMType(base))));
     }
+    if (collect) {
+        values.push_back(getPointerMap(base, true));
+    }
     value_ = builder_.CreateCall(FunctionCallee(fun), values);
     // TODO Remove next line (bit-cast) once non-opaque pointers are no longer supported
     Value *value = builder_.CreateBitCast(value_, getLLVMType(ptr));
@@ -2429,6 +2719,139 @@ Value *LLVMIRBuilder::processGEP(Type *base, Value *value, vector<Value *> &indi
     return value;
 }
 
+bool LLVMIRBuilder::hasPointers(TypeNode *type) {
+    if (type->isPointer()) {
+        return true;
+    }
+    if (type->isRecord()) {
+        const auto record_t = dynamic_cast<RecordTypeNode *>(type);
+        if (record_t->isExtended() && hasPointers(record_t->getBaseType())) {
+            return true;
+        }
+        for (size_t i = 0; i < record_t->getFieldCount(); ++i) {
+            if (hasPointers(record_t->getField(i)->getType())) {
+                return true;
+            }
+        }
+    } else if (type->isArray()) {
+        const auto array_t = dynamic_cast<ArrayTypeNode *>(type);
+        return !array_t->isOpen() && hasPointers(array_t->getElementType());
+    }
+    return false;
+}
+
+void LLVMIRBuilder::getPointerOffsets(TypeNode *type, const uint64_t offset, vector<Constant *> &offsets) {
+    const auto layout = module_->getDataLayout();
+    if (type->isPointer()) {
+        offsets.push_back(builder_.getInt64(offset));
+    } else if (type->isRecord()) {
+        const auto record_t = dynamic_cast<RecordTypeNode *>(type);
+        const auto structLayout = layout.getStructLayout(dyn_cast<StructType>(getLLVMType(type)));
+        unsigned idx = 0;
+        if (record_t->isExtended()) {
+            const uint64_t field = structLayout->getElementOffset(idx++);
+            getPointerOffsets(record_t->getBaseType(), offset + field, offsets);
+        }
+        for (size_t i = 0; i < record_t->getFieldCount(); ++i) {
+            const uint64_t field = structLayout->getElementOffset(idx++);
+            getPointerOffsets(record_t->getField(i)->getType(), offset + field, offsets);
+        }
+    } else if (type->isArray() && hasPointers(type)) {
+        const auto array_t = dynamic_cast<ArrayTypeNode *>(type);
+        const auto elem_t = array_t->getElementType();
+        const uint64_t size = layout.getTypeAllocSize(getLLVMType(elem_t));
+        const uint64_t length = dyn_cast<ArrayType>(getLLVMType(type))->getNumElements();
+        for (uint64_t i = 0; i < length; ++i) {
+            getPointerOffsets(elem_t, offset + i * size, offsets);
+        }
+    }
+}
+
+Constant *LLVMIRBuilder::getPointerMap(TypeNode *type, const bool heap) {
+    const auto key = std::make_pair(type, heap);
+    if (ptrMaps_.contains(key)) {
+        return ptrMaps_[key];
+    }
+    Constant *map = ConstantPointerNull::get(builder_.getPtrTy());
+    if (hasPointers(type)) {
+        // The offsets of a dynamically allocated record are relative to the start of the block, i.e., the type tag
+        uint64_t offset = 0;
+        if (heap && type->isRecord()) {
+            const auto blockTy = StructType::get(builder_.getContext(), {builder_.getPtrTy(), getLLVMType(type)});
+            offset = static_cast<uint64_t>(module_->getDataLayout().getStructLayout(blockTy)->getElementOffset(1));
+        }
+        vector<Constant *> offsets;
+        getPointerOffsets(type, offset, offsets);
+        const auto offsetsTy = ArrayType::get(builder_.getInt64Ty(), offsets.size());
+        const auto init = ConstantStruct::getAnon({builder_.getInt64(offsets.size()),
+                                                   ConstantArray::get(offsetsTy, offsets)});
+        const auto value = new GlobalVariable(*module_, init->getType(), true, GlobalValue::InternalLinkage,
+                                              init, type->isRecord() ? createScopedName(
+                                                      dynamic_cast<RecordTypeNode *>(type)) + "_ptrs" : "ptrs");
+        value->setAlignment(module_->getDataLayout().getABITypeAlign(builder_.getInt64Ty()));
+        map = value;
+    }
+    ptrMaps_[key] = map;
+    return map;
+}
+
+void LLVMIRBuilder::createGCRoot(AllocaInst *alloc, TypeNode *type) {
+    const auto nil = ConstantPointerNull::get(builder_.getPtrTy());
+    if (type->isPointer()) {
+        builder_.CreateIntrinsic(Intrinsic::gcroot, {}, {alloc, nil});
+    } else if (hasPointers(type)) {
+        // Shadow stack roots are pointers, structured variables are registered by their address and pointer map
+        const auto slot = builder_.CreateAlloca(builder_.getPtrTy(), nullptr, alloc->getName() + ".gc");
+        builder_.CreateStore(alloc, slot);
+        builder_.CreateIntrinsic(Intrinsic::gcroot, {}, {slot, getPointerMap(type, false)});
+    }
+}
+
+void LLVMIRBuilder::createGCRoots(ModuleNode &node) {
+    // The head of the shadow stack is defined by the GC lowering of LLVM in every module that uses it, registering
+    // its address ensures that the collector uses the same definition, even if the module is compiled just-in-time.
+    auto chain = module_->getGlobalVariable("llvm_gc_root_chain");
+    if (!chain) {
+        chain = new GlobalVariable(*module_, builder_.getPtrTy(), false, GlobalValue::ExternalLinkage,
+                                   nullptr, "llvm_gc_root_chain");
+    }
+    const auto globalTy = StructType::get(builder_.getContext(), {builder_.getPtrTy(), builder_.getPtrTy()});
+    vector<Constant *> globals;
+    for (size_t i = 0; i < node.getVariableCount(); ++i) {
+        const auto variable = node.getVariable(i);
+        if (hasPointers(variable->getType())) {
+            const auto value = dyn_cast<Constant>(values_[variable]);
+            globals.push_back(ConstantStruct::get(globalTy, {value, getPointerMap(variable->getType(), false)}));
+        }
+    }
+    Constant *table = ConstantPointerNull::get(builder_.getPtrTy());
+    if (!globals.empty()) {
+        const auto tableTy = ArrayType::get(globalTy, globals.size());
+        const auto value = new GlobalVariable(*module_, tableTy, true, GlobalValue::InternalLinkage,
+                                              ConstantArray::get(tableTy, globals),
+                                              node.getIdentifier()->name() + "_gc");
+        value->setAlignment(module_->getDataLayout().getABITypeAlign(tableTy));
+        table = value;
+    }
+    const auto funTy = FunctionType::get(builder_.getVoidTy(),
+                                         {builder_.getPtrTy(), builder_.getPtrTy(), builder_.getInt64Ty()}, false);
+    const auto fun = module_->getOrInsertFunction("olang_gc_register", funTy);
+    builder_.CreateCall(fun, {chain, table, builder_.getInt64(globals.size())});
+}
+
+Value *LLVMIRBuilder::createGCTemporary(Value *value) {
+    // A pointer returned by a function procedure is kept in a root of its own until the call is executed again, so
+    // that it is not collected while the other operands of the same expression or statement are evaluated.
+    auto &entry = function_->getEntryBlock();
+    IRBuilder<> builder(&entry, entry.getFirstInsertionPt());
+    const auto nil = ConstantPointerNull::get(builder_.getPtrTy());
+    const auto slot = builder.CreateAlloca(builder_.getPtrTy(), nullptr, "tmp.gc");
+    builder.CreateStore(nil, slot);
+    builder.CreateIntrinsic(Intrinsic::gcroot, {}, {slot, nil});
+    builder_.CreateStore(value, slot);
+    return value;
+}
+
 Type* LLVMIRBuilder::getLLVMType(TypeNode *type) {
     // Null type is mapped to void.
     if (type == nullptr) {
@@ -57,7 +57,10 @@ private:
     map<RecordTypeNode*, GlobalValue*> recTypeIds_;
     map<RecordTypeNode*, GlobalValue*> recTypeTds_;
     map<DeclarationNode *, Value *> valueTds_;
+    map<std::pair<TypeNode *, bool>, Constant *> ptrMaps_;
     stack<BasicBlock *> loopTails_;
+    unordered_set<ForLoopNode *> guarded_;
+    stack<Value *> overflows_;
     map<string, Constant*> strings_;
     stack<bool> deref_ctx;
     unsigned int scope_;
@@ -67,6 +70,15 @@ private:
     ASTContext *ast_{};
     StructType *recordTdTy_;
 
+    // Fields of the type descriptor of a record type
+    static constexpr unsigned TD_DISPLAY = 0;
+    static constexpr unsigned TD_IDS = 1;
+    static constexpr unsigned TD_LEVEL = 2;
+    // Number of extension levels whose type ids are stored in the type descriptor itself
+    static constexpr unsigned TD_DISPLAY_SIZE = 8;
+    // Maximum length of the shorter operand of a string comparison that is compiled inline
+    static constexpr uint64_t STRING_INLINE_LENGTH = 32;
+
     Type *getLLVMType(TypeNode *type);
     MaybeAlign getLLVMAlign(TypeNode *type);
 
@@ -80,6 +92,13 @@ private:
 
     Value *getTypeDescriptor(Value *, const NodeReference *, TypeNode *);
 
+    bool hasPointers(TypeNode *);
+    void getPointerOffsets(TypeNode *, uint64_t, vector<Constant *> &);
+    Constant *getPointerMap(TypeNode *, bool);
+    void createGCRoot(AllocaInst *, TypeNode *);
+    void createGCRoots(ModuleNode &);
+    Value *createGCTemporary(Value *);
+
     string qualifiedName(DeclarationNode *) const;
     string createScopedName(const RecordTypeNode *) const;
 
@@ -89,6 +108,9 @@ private:
 
     void ensureTerminator(BasicBlock *);
 
+    void createForLoop(ForLoopNode &, BasicBlock *, BasicBlock *, int64_t);
+    Value *createLoopGuard(ForLoopNode &, Value *, Value *, int64_t);
+
     void cast(const ExpressionNode &);
 
     FunctionType *createFunctionType(ProcedureTypeNode &, CallingConvention);
@@ -101,23 +123,28 @@ private:
 
     void installTrap(Value *, uint8_t);
     void trapOutOfBounds(Value *, Value *, Value *);
+    [[nodiscard]] bool isBoundsChecked(const ArrayIndex *, size_t) const;
     void trapTypeGuard(Value *);
     void trapCopyOverflow(Value *, Value *);
     void trapNILPtr(Value *);
     void trapIntDivByZero(Value *);
     void trapAssert(Value *);
     Value *trapIntOverflow(Intrinsic::ID, Value*, Value*);
+    Value *deferIntOverflow(Intrinsic::ID, Value*, Value*);
     void trapFltDivByZero(Value *);
     void trapSignConversion(Value *);
 
     void checkSignConversion(ExpressionNode &, Value *);
 
     Value *createTypeTest(Value *, TypeNode *);
+    Value *createDisplayTest(Value *, RecordTypeNode *);
     Value *createTypeTest(Value *, const NodeReference *, const TypeNode *, TypeNode *);
 
     void createNumericTestCase(const CaseOfNode &, BasicBlock *, BasicBlock *);
     void createTypeTestCase(const CaseOfNode &, BasicBlock *, BasicBlock *);
 
+    Value *getStringLength(ExpressionNode *);
+    Value *createInlineStringComparison(Value *, uint64_t, Value *, uint64_t);
     Value *createStringComparison(const BinaryExpressionNode *);
 
     Value *createNeg(Value *);
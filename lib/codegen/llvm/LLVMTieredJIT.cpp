@@ -0,0 +1,271 @@
+/*
+ * Tiered execution of Oberon modules based on the lazy JIT of the LLVM compiler infrastructure.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#include "LLVMTieredJIT.h"
+
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+
+using namespace llvm;
+
+// Suffix of the names of the optimized procedures.
+static const string TIER = ".tier2";
+
+LLVMTieredJIT::LLVMTieredJIT(Logger &logger, orc::LLLazyJIT &jit, const uint32_t threshold) :
+        logger_(logger), jit_(jit), threshold_(threshold), bitcode_(), procs_(), table_(), addrs_(nullptr), stopped_(false),
+        compiled_(0), recompiled_(0), failed_(0), micros_(0) {
+    // Count the procedures that are compiled without optimizations, the lazy JIT compiles one procedure at a time
+    jit_.getIRTransformLayer().setTransform(
+            [this](orc::ThreadSafeModule tsm, orc::MaterializationResponsibility &) -> Expected<orc::ThreadSafeModule> {
+                tsm.withModuleDo([this](const Module &module) {
+                    for (const auto &fn : module) {
+                        if (!fn.isDeclaration() && !fn.getName().ends_with(TIER)) {
+                            ++compiled_;
+                        }
+                    }
+                });
+                return tsm;
+            });
+    // Hot procedures call back into the compiler
+    cantFail(jit_.getMainJITDylib().define(
+            orc::absoluteSymbols({{jit_.mangleAndIntern("olang_jit_hot"),
+                                   {orc::ExecutorAddr::fromPtr(&LLVMTieredJIT::hot), JITSymbolFlags::Exported}}})));
+    worker_ = std::thread(&LLVMTieredJIT::run, this);
+}
+
+LLVMTieredJIT::~LLVMTieredJIT() {
+    stop();
+}
+
+Error LLVMTieredJIT::add(orc::ThreadSafeModule tsm) {
+    tsm.withModuleDo([this](Module &module) {
+        prepare(module);
+        raw_svector_ostream out(bitcode_);
+        WriteBitcodeToFile(module, out);
+        instrument(module);
+    });
+    logger_.debug("Tiered JIT: " + std::to_string(procs_.size()) + " procedure(s) are compiled on first call.");
+    return jit_.addLazyIRModule(std::move(tsm));
+}
+
+void LLVMTieredJIT::stop() {
+    {
+        std::lock_guard guard(lock_);
+        stopped_ = true;
+        queue_.clear();
+    }
+    cond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+string LLVMTieredJIT::getStatistics() const {
+    return std::to_string(compiled_.load()) + " procedure(s) compiled without optimizations, " +
+           std::to_string(recompiled_.load()) + " procedure(s) recompiled with optimizations in " +
+           std::to_string(micros_.load() / 1000) + " ms" +
+           (failed_ == 0 ? "" : ", " + std::to_string(failed_.load()) + " recompilation(s) failed");
+}
+
+// Called by a procedure that has become hot, i.e., from the thread of the program.
+void LLVMTieredJIT::hot(LLVMTieredJIT *jit, const uint32_t index) {
+    {
+        std::lock_guard guard(jit->lock_);
+        if (jit->stopped_) {
+            return;
+        }
+        jit->queue_.push_back(index);
+    }
+    jit->cond_.notify_one();
+}
+
+// Prepares a module to be compiled one procedure at a time. The definitions of the module are shared by the
+// unoptimized and the optimized procedures, which are compiled to separate modules. Therefore, definitions that are
+// local to the module are made visible. Calls of the procedures of the module go through a table of procedure
+// addresses, which initially contains the unoptimized procedures.
+void LLVMTieredJIT::prepare(Module &module) {
+    const auto prefix = module.getName().str() + ".";
+    unsigned anonymous = 0;
+    for (auto &gv : module.global_values()) {
+        if (gv.isDeclaration()) {
+            continue;
+        }
+        if (!gv.hasName()) {
+            gv.setName(prefix + "anon." + std::to_string(anonymous++));
+        }
+        if (gv.hasLocalLinkage()) {
+            gv.setName(prefix + gv.getName());
+            gv.setLinkage(GlobalValue::ExternalLinkage);
+            gv.setVisibility(GlobalValue::HiddenVisibility);
+        }
+    }
+    vector<Constant *> procs;
+    for (auto &fn : module) {
+        if (!fn.isDeclaration()) {
+            procs.push_back(&fn);
+            procs_.push_back(fn.getName().str());
+        }
+    }
+    auto *ptrTy = PointerType::getUnqual(module.getContext());
+    auto *type = ArrayType::get(ptrTy, procs.size());
+    table_ = prefix + "jit.table";
+    auto *table = new GlobalVariable(module, type, false, GlobalValue::ExternalLinkage,
+                                     ConstantArray::get(type, procs), table_);
+    table->setVisibility(GlobalValue::HiddenVisibility);
+    const auto align = module.getDataLayout().getPointerABIAlignment(0);
+    for (uint32_t i = 0; i < procs.size(); ++i) {
+        for (auto *user : make_early_inc_range(procs[i]->users())) {
+            const auto call = dyn_cast<CallBase>(user);
+            if (!call || call->getCalledOperand() != procs[i]) {
+                continue;
+            }
+            IRBuilder<> builder(call);
+            const auto slot = builder.CreateConstInBoundsGEP2_32(type, table, 0, i);
+            // The entry is replaced by the thread that recompiles the procedure
+            const auto load = builder.CreateAlignedLoad(ptrTy, slot, align);
+            load->setAtomic(AtomicOrdering::Monotonic);
+            call->setCalledOperand(load);
+        }
+    }
+}
+
+// Counts the calls of every procedure of the module and calls back into the compiler once it has become hot.
+void LLVMTieredJIT::instrument(Module &module) const {
+    auto &context = module.getContext();
+    auto *i32 = Type::getInt32Ty(context);
+    auto *ptrTy = PointerType::getUnqual(context);
+    auto *type = ArrayType::get(i32, procs_.size());
+    auto *calls = new GlobalVariable(module, type, false, GlobalValue::InternalLinkage,
+                                     ConstantAggregateZero::get(type), "olang.jit.calls");
+    const auto hot = module.getOrInsertFunction("olang_jit_hot",
+                                                FunctionType::get(Type::getVoidTy(context), {ptrTy, i32}, false));
+    const auto self = ConstantExpr::getIntToPtr(
+            ConstantInt::get(module.getDataLayout().getIntPtrType(context), reinterpret_cast<uintptr_t>(this)), ptrTy);
+    for (uint32_t i = 0; i < procs_.size(); ++i) {
+        auto *fn = module.getFunction(procs_[i]);
+        auto &entry = fn->getEntryBlock();
+        // The local variables and the roots of the garbage collector remain in the entry block
+        auto pos = entry.getFirstInsertionPt();
+        while (isa<AllocaInst>(*pos) ||
+               (isa<IntrinsicInst>(*pos) && cast<IntrinsicInst>(*pos).getIntrinsicID() == Intrinsic::gcroot)) {
+            ++pos;
+        }
+        auto *body = entry.splitBasicBlock(pos, "tier.body");
+        auto *up = BasicBlock::Create(context, "tier.up", fn, body);
+        entry.getTerminator()->eraseFromParent();
+        IRBuilder<> builder(&entry);
+        const auto slot = builder.CreateConstInBoundsGEP2_32(type, calls, 0, i);
+        const auto count = builder.CreateAdd(builder.CreateLoad(i32, slot), builder.getInt32(1));
+        builder.CreateStore(count, slot);
+        builder.CreateCondBr(builder.CreateICmpEQ(count, builder.getInt32(threshold_)), up, body);
+        builder.SetInsertPoint(up);
+        builder.CreateCall(hot, {self, builder.getInt32(i)});
+        builder.CreateBr(body);
+    }
+}
+
+void LLVMTieredJIT::run() {
+    // Optimize for the host, as the code is executed there
+    unique_ptr<TargetMachine> tm;
+    if (auto builder = orc::JITTargetMachineBuilder::detectHost()) {
+        if (auto machine = builder->createTargetMachine()) {
+            tm = std::move(machine.get());
+        } else {
+            consumeError(machine.takeError());
+        }
+    } else {
+        consumeError(builder.takeError());
+    }
+    while (true) {
+        uint32_t index;
+        {
+            std::unique_lock guard(lock_);
+            cond_.wait(guard, [this] { return stopped_ || !queue_.empty(); });
+            if (stopped_) {
+                return;
+            }
+            index = queue_.front();
+            queue_.pop_front();
+        }
+        const auto start = clock::now();
+        if (auto err = recompile(index, tm.get())) {
+            // The procedure continues to run without optimizations
+            consumeError(std::move(err));
+            ++failed_;
+        } else {
+            ++recompiled_;
+        }
+        micros_ += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    }
+}
+
+Error LLVMTieredJIT::recompile(const uint32_t index, TargetMachine *tm) {
+    const auto &name = procs_[index];
+    // Every procedure is optimized in a context of its own, so that the program can continue to compile procedures
+    auto context = std::make_unique<LLVMContext>();
+    auto parsed = parseBitcodeFile(MemoryBufferRef(StringRef(bitcode_.data(), bitcode_.size()), name), *context);
+    if (!parsed) {
+        return parsed.takeError();
+    }
+    auto module = std::move(parsed.get());
+    // Keep the procedure and declare everything else, which is defined by the module that is already running
+    vector<GlobalVariable *> erased;
+    for (auto &gv : module->globals()) {
+        if (gv.getName().starts_with("llvm.")) {
+            erased.push_back(&gv);
+        } else if (!gv.isDeclaration()) {
+            gv.setInitializer(nullptr);
+            gv.setComdat(nullptr);
+            gv.setLinkage(GlobalValue::ExternalLinkage);
+        }
+    }
+    for (const auto gv : erased) {
+        gv->eraseFromParent();
+    }
+    for (auto &fn : *module) {
+        if (!fn.isDeclaration() && fn.getName() != name) {
+            fn.deleteBody();
+            fn.setComdat(nullptr);
+        }
+    }
+    auto *fn = module->getFunction(name);
+    fn->setName(name + TIER);
+    fn->setLinkage(GlobalValue::ExternalLinkage);
+    fn->setVisibility(GlobalValue::HiddenVisibility);
+    PassBuilder pb(tm);
+    LoopAnalysisManager lam;
+    FunctionAnalysisManager fam;
+    CGSCCAnalysisManager cgam;
+    ModuleAnalysisManager mam;
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+    auto mpm = pb.buildPerModuleDefaultPipeline(OptimizationLevel::O2);
+    mpm.run(*module, mam);
+    if (auto err = jit_.addIRModule(orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+        return err;
+    }
+    auto addr = jit_.lookup(name + TIER);
+    if (!addr) {
+        return addr.takeError();
+    }
+    if (!addrs_) {
+        auto table = jit_.lookup(table_);
+        if (!table) {
+            return table.takeError();
+        }
+        addrs_ = table->toPtr<void **>();
+    }
+    std::atomic_ref(addrs_[index]).store(addr->toPtr<void *>(), std::memory_order_release);
+    return Error::success();
+}
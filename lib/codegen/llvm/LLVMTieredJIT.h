@@ -0,0 +1,81 @@
+/*
+ * Tiered execution of Oberon modules based on the lazy JIT of the LLVM compiler infrastructure.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#ifndef OBERON_LANG_LLVMTIEREDJIT_H
+#define OBERON_LANG_LLVMTIEREDJIT_H
+
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include "Logger.h"
+
+using std::atomic;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+// Procedures of a module are compiled without optimizations when they are first called, see `LLLazyJIT`. Every call
+// of a procedure goes through a table of procedure addresses and is counted. Once a procedure has been called as often
+// as the threshold, which is set with `-fjit-threshold` and defaults to 1000 calls, it is recompiled with optimizations
+// on a background thread and its entry in the table is replaced, so that all subsequent calls execute the optimized
+// code. An activation that is running when its procedure is replaced, such as the body of the module, continues to
+// execute the unoptimized code.
+class LLVMTieredJIT {
+
+public:
+    // Creates a tiered JIT that recompiles a procedure with optimizations once it has been called `threshold` times.
+    LLVMTieredJIT(Logger &, llvm::orc::LLLazyJIT &, uint32_t threshold);
+    ~LLVMTieredJIT();
+
+    llvm::Error add(llvm::orc::ThreadSafeModule);
+    // Discards the pending recompilations and waits for the running one.
+    void stop();
+    [[nodiscard]] string getStatistics() const;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    Logger &logger_;
+    llvm::orc::LLLazyJIT &jit_;
+    uint32_t threshold_;
+    // Bitcode of the module before it is instrumented, which is the source of the optimized procedures
+    llvm::SmallVector<char, 0> bitcode_;
+    vector<string> procs_;
+    string table_;
+    void **addrs_;
+    std::thread worker_;
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::deque<uint32_t> queue_;
+    bool stopped_;
+    atomic<unsigned> compiled_, recompiled_, failed_;
+    atomic<int64_t> micros_;
+
+    static void hot(LLVMTieredJIT *, uint32_t);
+
+    void prepare(llvm::Module &);
+    void instrument(llvm::Module &) const;
+    void run();
+    llvm::Error recompile(uint32_t, llvm::TargetMachine *);
+
+};
+
+
+#endif //OBERON_LANG_LLVMTIEREDJIT_H
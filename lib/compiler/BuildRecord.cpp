@@ -0,0 +1,104 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#include "BuildRecord.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "data/symtab/SymbolFile.h"
+
+using std::ifstream;
+using std::istringstream;
+using std::ofstream;
+using std::ostringstream;
+
+BuildRecord::BuildRecord(CompilerConfig &config, const path &source, const path &output) :
+        output_(output), file_(path(output).concat(".dep")), source_(hash(source)), options_(options(config)),
+        symbols_(), imports_() {}
+
+void BuildRecord::setSymbolFile(const path &file, const int64_t key) {
+    symbols_ = {file, key};
+}
+
+void BuildRecord::addImport(const path &file, const int64_t key) {
+    imports_.emplace_back(file, key);
+}
+
+bool BuildRecord::isUpToDate() const {
+    if (!std::filesystem::exists(output_)) {
+        return false;
+    }
+    ifstream in(file_);
+    string line, tag;
+    int version = 0;
+    uint64_t source = 0;
+    if (!(in >> version >> tag >> std::hex >> source >> std::dec) || version != VERSION || tag != "source" ||
+        source != source_) {
+        return false;
+    }
+    in.ignore(1);
+    if (!std::getline(in, line) || line != "options " + options_) {
+        return false;
+    }
+    bool symbols = false;
+    while (std::getline(in, line)) {
+        istringstream entry(line);
+        int64_t key;
+        string file;
+        if (!(entry >> tag >> key) || (tag != "symbols" && tag != "import")) {
+            return false;
+        }
+        entry.ignore(1);
+        std::getline(entry, file);
+        // the symbol file has been removed or its interface has changed
+        if (!std::filesystem::exists(file) || SymbolFile::readKey(file) != key) {
+            return false;
+        }
+        symbols = symbols || tag == "symbols";
+    }
+    return symbols;
+}
+
+void BuildRecord::save() const {
+    ofstream out(file_, std::ios::out | std::ios::trunc);
+    out << VERSION << std::endl;
+    out << "source " << std::hex << source_ << std::dec << std::endl;
+    out << "options " << options_ << std::endl;
+    out << "symbols " << symbols_.second << " " << symbols_.first.string() << std::endl;
+    for (const auto &[file, key] : imports_) {
+        out << "import " << key << " " << file.string() << std::endl;
+    }
+}
+
+uint64_t BuildRecord::hash(const path &file) {
+    ifstream in(file, std::ios::in | std::ios::binary);
+    const string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return static_cast<uint64_t>(SymbolFile::checksum(data.data(), data.size()));
+}
+
+string BuildRecord::options(CompilerConfig &config) {
+    ostringstream out;
+    out << static_cast<int>(config.getLanguageStandard()) << ":" << static_cast<int>(config.getFileType()) << ":"
+        << static_cast<int>(config.getOptimizationLevel()) << ":" << static_cast<int>(config.getRelocationModel())
+        << ":" << config.getTargetTriple() << ":" << config.getProfileFile() << ":";
+    for (auto flag = static_cast<uint8_t>(Flag::ENABLE_EXTERN); flag <= static_cast<uint8_t>(Flag::TIERED_JIT);
+         ++flag) {
+        out << (config.hasFlag(static_cast<Flag>(flag)) ? '1' : '0');
+    }
+    out << ":";
+    for (auto trap = static_cast<uint8_t>(Trap::OUT_OF_BOUNDS); trap <= static_cast<uint8_t>(Trap::TYPE_MISMATCH);
+         ++trap) {
+        out << (config.isSanitized(static_cast<Trap>(trap)) ? '1' : '0');
+    }
+    out << ":" << config.hasWarning(Warning::ERROR) << ":" << config.getPartitions();
+    // The search paths decide which symbol files the imports of the module are resolved to
+    for (const auto &dir : config.getIncludeDirectories()) {
+        out << ":I" << dir.string();
+    }
+    for (const auto &dir : config.getLibraryDirectories()) {
+        out << ":L" << dir.string();
+    }
+    return out.str();
+}
@@ -0,0 +1,57 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#ifndef OBERON_LANG_BUILDRECORD_H
+#define OBERON_LANG_BUILDRECORD_H
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CompilerConfig.h"
+
+using std::filesystem::path;
+using std::pair;
+using std::string;
+using std::vector;
+
+// Record of the inputs from which the output file of a module was generated. The record is stored next to the
+// output file and consists of a content hash of the source file, the compiler options and search paths that affect
+// the output, as well as the keys of the module's own symbol file and of the symbol files of all modules it imports. As the
+// key of a symbol file only changes if the interface of its module changes, a module is not compiled again if
+// only the implementation of a module that it imports has changed.
+class BuildRecord {
+
+public:
+    BuildRecord(CompilerConfig &config, const path &source, const path &output);
+    ~BuildRecord() = default;
+
+    void setSymbolFile(const path &, int64_t);
+    void addImport(const path &, int64_t);
+
+    // Checks whether the output file is up-to-date with respect to the record stored next to it.
+    [[nodiscard]] bool isUpToDate() const;
+    void save() const;
+
+    [[nodiscard]] static uint64_t hash(const path &);
+
+private:
+    path output_;
+    path file_;
+    uint64_t source_;
+    string options_;
+    pair<path, int64_t> symbols_;
+    vector<pair<path, int64_t>> imports_;
+
+    static string options(CompilerConfig &);
+
+    static constexpr int VERSION = 1;
+
+};
+
+
+#endif //OBERON_LANG_BUILDRECORD_H
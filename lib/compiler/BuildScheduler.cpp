@@ -0,0 +1,173 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#include "BuildScheduler.h"
+
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+#include "IdentToken.h"
+#include "Scanner.h"
+#include "ThreadPool.h"
+#include "codegen/CodeGenFactory.h"
+
+using std::function;
+using std::lock_guard;
+using std::make_unique;
+using std::mutex;
+using std::queue;
+using std::unordered_map;
+
+void BuildScheduler::compile(const vector<path> &inputs, const unsigned jobs) {
+    // Set up a separate compiler for every module on the main thread
+    vector<unique_ptr<Job>> modules;
+    for (auto &input : inputs) {
+        if (!std::filesystem::exists(input)) {
+            logger_.error(string(), "cannot open file: " + input.string() + ".");
+            continue;
+        }
+        auto job = make_unique<Job>();
+        job->file = input;
+        job->config = make_unique<CompilerConfig>(config_, job->out);
+        if (config_.getFileType() == OutputFileType::ExecutableFile) {
+            // The last module is the main module of the executable
+            job->config->toggleFlag(Flag::ENABLE_MAIN, &input == &inputs.back());
+        }
+        job->codegen = CodeGenFactory::GetCodeGen(CompilerBackend::LLVM, *job->config);
+        job->codegen->configure();
+        job->compiler = make_unique<Compiler>(*job->config, job->codegen.get());
+        modules.push_back(std::move(job));
+    }
+    if (!schedule(modules)) {
+        return;
+    }
+    logger_.debug("Compiling " + to_string(modules.size()) + " module(s) using " + to_string(jobs) + " job(s).");
+    ThreadPool pool(jobs);
+    mutex lock;
+    function<void(size_t)> submit = [&](const size_t idx) {
+        pool.submit([&, idx] {
+            const auto job = modules[idx].get();
+            job->config->logger().debug("Compiling module " + to_string(job->file) + ".");
+            job->compiler->compile(job->file, [&] {
+                // The symbol file of this module has been written, release the modules that import it
+                lock_guard guard(lock);
+                for (const auto dependent : job->dependents) {
+                    if (--modules[dependent]->pending == 0) {
+                        submit(dependent);
+                    }
+                }
+            });
+        });
+    };
+    {
+        lock_guard guard(lock);
+        for (size_t i = 0; i < modules.size(); ++i) {
+            if (modules[i]->pending == 0) {
+                submit(i);
+            }
+        }
+    }
+    pool.wait();
+    // Report the buffered messages in the order of the input files
+    for (const auto &job : modules) {
+        out_ << job->out.str();
+        logger_.merge(job->config->logger());
+    }
+    out_.flush();
+}
+
+bool BuildScheduler::schedule(vector<unique_ptr<Job>> &modules) const {
+    unordered_map<string, size_t> names;
+    vector<vector<string>> deps;
+    for (size_t i = 0; i < modules.size(); ++i) {
+        const auto job = modules[i].get();
+        job->name = job->file.stem().string();
+        deps.push_back(imports(job->file, job->name));
+        names.try_emplace(job->name, i);
+    }
+    // Only imports of modules that are part of the same build introduce a dependency
+    for (size_t i = 0; i < modules.size(); ++i) {
+        for (const auto &dep : deps[i]) {
+            if (auto it = names.find(dep); it != names.end() && it->second != i) {
+                modules[it->second]->dependents.push_back(i);
+                ++modules[i]->pending;
+            }
+        }
+    }
+    // Check that the import graph is acyclic
+    vector<size_t> pending;
+    queue<size_t> ready;
+    for (size_t i = 0; i < modules.size(); ++i) {
+        pending.push_back(modules[i]->pending);
+        if (pending[i] == 0) {
+            ready.push(i);
+        }
+    }
+    size_t visited = 0;
+    while (!ready.empty()) {
+        const auto idx = ready.front();
+        ready.pop();
+        ++visited;
+        for (const auto dependent : modules[idx]->dependents) {
+            if (--pending[dependent] == 0) {
+                ready.push(dependent);
+            }
+        }
+    }
+    if (visited != modules.size()) {
+        for (size_t i = 0; i < modules.size(); ++i) {
+            if (pending[i] != 0) {
+                logger_.error(modules[i]->file.string(), "cyclic import involving module " + modules[i]->name + ".");
+            }
+        }
+        return false;
+    }
+    return true;
+}
+
+vector<string> BuildScheduler::imports(const path &file, string &name) {
+    vector<string> result;
+    // Errors are reported once the module is compiled
+    Logger logger(LogLevel::QUIET, cout);
+    try {
+        Scanner scanner(logger, file);
+        // module = "MODULE" ident ";" [ import_list ] ...
+        if (scanner.next()->type() != TokenType::kw_module) {
+            return result;
+        }
+        auto token = scanner.next();
+        if (token->type() != TokenType::const_ident) {
+            return result;
+        }
+        name = dynamic_cast<const IdentToken *>(token.get())->value();
+        if (scanner.next()->type() != TokenType::semicolon || scanner.peek()->type() != TokenType::kw_import) {
+            return result;
+        }
+        scanner.next();  // skip IMPORT keyword
+        // import_list = IMPORT import { "," import } ";" .
+        // import = ident [":=" ident] .
+        while (true) {
+            token = scanner.next();
+            if (token->type() != TokenType::const_ident) {
+                break;
+            }
+            if (scanner.peek()->type() == TokenType::op_becomes) {
+                scanner.next();  // skip := operator
+                token = scanner.next();
+                if (token->type() != TokenType::const_ident) {
+                    break;
+                }
+            }
+            result.push_back(dynamic_cast<const IdentToken *>(token.get())->value());
+            if (scanner.next()->type() != TokenType::comma) {
+                break;
+            }
+        }
+    } catch (const CompilerError &) {
+        // The module cannot be scanned, which is also reported once it is compiled
+    }
+    return result;
+}
@@ -0,0 +1,66 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#ifndef OBERON_LANG_BUILDSCHEDULER_H
+#define OBERON_LANG_BUILDSCHEDULER_H
+
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Logger.h"
+#include "Compiler.h"
+#include "CompilerConfig.h"
+#include "codegen/CodeGen.h"
+
+using std::cout;
+using std::filesystem::path;
+using std::ostream;
+using std::ostringstream;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+// Compiles several modules in parallel. The import graph of the input modules is used to schedule a module as
+// soon as the symbol files of all imported modules that are part of the same build have been written. Every
+// module is compiled by its own compiler with its own AST context, semantic analysis, and code generator. The
+// messages of each module are buffered and reported in the order of the input files once all modules are done.
+class BuildScheduler {
+
+public:
+    explicit BuildScheduler(CompilerConfig &config, ostream &out = cout) :
+            config_(config), logger_(config.logger()), out_(out) {};
+    ~BuildScheduler() = default;
+
+    void compile(const vector<path> &, unsigned);
+
+    // Returns the names of the modules imported by the given module without running the full front-end.
+    [[nodiscard]] static vector<string> imports(const path &, string &);
+
+private:
+    struct Job {
+        path file;
+        string name;
+        vector<size_t> dependents;
+        size_t pending{0};
+        ostringstream out;
+        unique_ptr<CompilerConfig> config;
+        unique_ptr<CodeGen> codegen;
+        unique_ptr<Compiler> compiler;
+    };
+
+    CompilerConfig &config_;
+    Logger &logger_;
+    ostream &out_;
+
+    bool schedule(vector<unique_ptr<Job>> &) const;
+
+};
+
+
+#endif //OBERON_LANG_BUILDSCHEDULER_H
@@ -0,0 +1,196 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#include "CompileServer.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <system_error>
+
+#include "global.h"
+#include "Interner.h"
+#include "data/symtab/ImportCache.h"
+#include "system/OberonSystem.h"
+
+#ifndef _WINAPI
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using std::ostringstream;
+
+#ifndef _WINAPI
+static bool readAll(const int fd, void *buf, size_t len) {
+    auto ptr = static_cast<char *>(buf);
+    while (len > 0) {
+        const auto res = ::read(fd, ptr, len);
+        if (res <= 0) {
+            return false;
+        }
+        ptr += res;
+        len -= static_cast<size_t>(res);
+    }
+    return true;
+}
+
+static bool writeAll(const int fd, const void *buf, size_t len) {
+    auto ptr = static_cast<const char *>(buf);
+    while (len > 0) {
+        const auto res = ::write(fd, ptr, len);
+        if (res <= 0) {
+            return false;
+        }
+        ptr += res;
+        len -= static_cast<size_t>(res);
+    }
+    return true;
+}
+
+static bool readString(const int fd, string &str) {
+    uint32_t len = 0;
+    if (!readAll(fd, &len, sizeof(len))) {
+        return false;
+    }
+    str.resize(len);
+    return readAll(fd, str.data(), len);
+}
+
+static bool writeString(const int fd, const string &str) {
+    const auto len = static_cast<uint32_t>(str.size());
+    return writeAll(fd, &len, sizeof(len)) && writeAll(fd, str.data(), len);
+}
+
+static int openSocket(const path &socket, sockaddr_un &addr) {
+    const auto name = socket.string();
+    if (name.size() >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, name.c_str(), name.size() + 1);
+    return ::socket(AF_UNIX, SOCK_STREAM, 0);
+}
+#endif
+
+int CompileServer::serve(const Handler &handler) {
+#ifndef _WINAPI
+    sockaddr_un addr{};
+    const int fd = openSocket(socket_, addr);
+    if (fd < 0) {
+        logger_.error(socket_.string(), "cannot create server socket.");
+        return EXIT_FAILURE;
+    }
+    // Remove the socket of a previous server that has not been shut down properly
+    ::unlink(addr.sun_path);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+        logger_.error(socket_.string(), string("cannot listen on server socket: ") + std::strerror(errno) + ".");
+        ::close(fd);
+        return EXIT_FAILURE;
+    }
+    // Clients that disconnect early must not terminate the server
+    std::signal(SIGPIPE, SIG_IGN);
+    logger_.info("Listening on '" + socket_.string() + "'.");
+    while (true) {
+        const int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logger_.error(socket_.string(), string("cannot accept connection: ") + std::strerror(errno) + ".");
+            break;
+        }
+        // request: working directory, number of arguments, arguments
+        string cwd;
+        uint32_t count = 0;
+        vector<string> args;
+        bool valid = readString(client, cwd) && readAll(client, &count, sizeof(count));
+        for (uint32_t i = 0; valid && i < count; ++i) {
+            string arg;
+            valid = readString(client, arg);
+            args.push_back(arg);
+        }
+        if (valid) {
+            ostringstream out;
+            int status = EXIT_FAILURE;
+            std::error_code ec;
+            std::filesystem::current_path(cwd, ec);
+            if (ec) {
+                out << "cannot change into working directory '" << cwd << "': " << ec.message() << "." << std::endl;
+            } else {
+                logger_.debug("Processing request in '" + cwd + "'.");
+                try {
+                    status = handler(args, out);
+                } catch (const std::exception &e) {
+                    // An error that escapes the compiler only fails the request, not the server
+                    out << "error: " << e.what() << std::endl;
+                    status = EXIT_FAILURE;
+                }
+            }
+            // response: output, exit code
+            const auto code = static_cast<int32_t>(status);
+            if (!writeString(client, out.str()) || !writeAll(client, &code, sizeof(code))) {
+                logger_.debug("Client disconnected before receiving the response.");
+            }
+        }
+        ::close(client);
+        // The cached imports and the shared basic types are the only names that outlive a request, release them
+        // once there are too many
+        if (Interner::size() > names_) {
+            logger_.debug("Resetting the import cache and " + std::to_string(Interner::size()) + " interned names.");
+            ImportCache::instance().clear();
+            OberonSystem::releaseBasicTypes();
+            Interner::reset();
+        }
+    }
+    ::close(fd);
+    ::unlink(addr.sun_path);
+    return EXIT_FAILURE;
+#else
+    logger_.error(socket_.string(), "compile server is not supported on this platform.");
+    static_cast<void>(handler);
+    return EXIT_FAILURE;
+#endif
+}
+
+optional<int> CompileServer::forward(const path &socket, const vector<string> &args, ostream &out) {
+#ifndef _WINAPI
+    sockaddr_un addr{};
+    const int fd = openSocket(socket, addr);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    std::error_code ec;
+    bool valid = writeString(fd, std::filesystem::current_path(ec).string());
+    const auto count = static_cast<uint32_t>(args.size());
+    valid = valid && writeAll(fd, &count, sizeof(count));
+    for (const auto &arg : args) {
+        valid = valid && writeString(fd, arg);
+    }
+    string output;
+    int32_t code = EXIT_FAILURE;
+    valid = valid && readString(fd, output) && readAll(fd, &code, sizeof(code));
+    ::close(fd);
+    if (!valid) {
+        return std::nullopt;
+    }
+    out << output;
+    out.flush();
+    return code;
+#else
+    static_cast<void>(socket);
+    static_cast<void>(args);
+    static_cast<void>(out);
+    return std::nullopt;
+#endif
+}
@@ -0,0 +1,58 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#ifndef OBERON_LANG_COMPILESERVER_H
+#define OBERON_LANG_COMPILESERVER_H
+
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Logger.h"
+
+using std::filesystem::path;
+using std::function;
+using std::optional;
+using std::ostream;
+using std::string;
+using std::vector;
+
+// Compile server that keeps the compiler resident in memory, so that the initialization of the back-end and the
+// modules in the import cache are reused across requests. A request consists of the working directory and the
+// command line arguments of a compiler invocation, the response of the output and the exit code of that invocation.
+// Requests are processed one at a time, as the server changes into the working directory of each request. An error
+// that aborts a compilation only fails the request that caused it.
+class CompileServer {
+
+public:
+    using Handler = function<int(const vector<string> &, ostream &)>;
+
+    // Default number of interned names above which the import cache and the interner are reset after a request.
+    static constexpr size_t MAX_NAMES = 1u << 20;
+
+    CompileServer(Logger &logger, const path &socket, const size_t names = MAX_NAMES) :
+            logger_(logger), socket_(socket), names_(names) {};
+    ~CompileServer() = default;
+
+    // Listens on the socket and processes requests until the process is terminated.
+    int serve(const Handler &);
+
+    // Forwards a command line to the server listening on the given socket and writes the output of the request
+    // to the given stream. Returns the exit code of the request or nothing, if no server could be reached.
+    static optional<int> forward(const path &, const vector<string> &, ostream &);
+
+private:
+    Logger &logger_;
+    path socket_;
+    size_t names_;
+
+};
+
+
+#endif //OBERON_LANG_COMPILESERVER_H
@@ -5,18 +5,41 @@
 #include "Compiler.h"
 
 #include <filesystem>
+#include <optional>
 
+#include "BuildRecord.h"
 #include "Scanner.h"
 #include "parser/Parser.h"
+#include "analyzer/BoundsCheckEliminator.h"
 #include "analyzer/LambdaLifter.h"
+#include "analyzer/OverflowCheckCombiner.h"
 #include "data/ast/NodePrettyPrinter.h"
+#include "data/symtab/ImportCache.h"
+#include "data/symtab/SymbolExporter.h"
+#include "data/symtab/SymbolFile.h"
 
 using std::filesystem::path;
+using std::optional;
 
 unique_ptr<ASTContext> Compiler::run(const path &file) {
+    try {
+        return analyze(file);
+    } catch (const CompilerError &e) {
+        if (e.pos().fileName.empty()) {
+            logger_.error(string(), e.what());
+        } else {
+            logger_.error(e.pos(), e.what());
+        }
+        return nullptr;
+    }
+}
+
+unique_ptr<ASTContext> Compiler::analyze(const path &file) {
     // Scan, parse, and analyze the input file
     logger_.debug("Parsing and analyzing...");
     const int errors = logger_.getErrorCount();
+    // every module is analyzed with a fresh symbol table, imported modules are shared through the import cache
+    system_ = std::make_unique<Oberon07>();
     Scanner scanner(logger_, file);
     auto ast = std::make_unique<ASTContext>(file);
     Sema sema(config_, ast.get(), system_.get());
@@ -36,6 +59,8 @@ unique_ptr<ASTContext> Compiler::run(const path &file) {
     logger_.debug("Transforming...");
     const auto analyzer = std::make_unique<Analyzer>(config_);
     analyzer->add(std::make_unique<LambdaLifter>(ast.get()));
+    analyzer->add(std::make_unique<BoundsCheckEliminator>(config_));
+    analyzer->add(std::make_unique<OverflowCheckCombiner>(config_));
     analyzer->run(module);
 #ifdef _DEBUG
     const auto printer = std::make_unique<NodePrettyPrinter>(std::cout);
@@ -44,11 +69,37 @@ unique_ptr<ASTContext> Compiler::run(const path &file) {
     return ast;
 }
 
-void Compiler::compile(const path &file) {
+void Compiler::compile(const path &file, const function<void()> &callback) {
     const auto path = absolute(file);
+    // The record of the inputs is only built, and the source file hashed, for incremental builds
+    optional<BuildRecord> record;
+    if (config_.hasFlag(Flag::INCREMENTAL)) {
+        record.emplace(config_, path, codegen_->getOutputFile(path));
+    }
+    if (record && record->isUpToDate()) {
+        logger_.debug("Module " + to_string(file) + " is up-to-date.");
+        if (callback) {
+            callback();
+        }
+        return;
+    }
+    const int errors = logger_.getErrorCount();
     const auto ast = run(file);
+    if (callback) {
+        callback();
+    }
     if (ast) {
         codegen_->generate(ast.get(), path.string());
+        if (record && logger_.getErrorCount() == errors) {
+            // Record the inputs of the generated output file for the next build
+            const auto name = ast->getTranslationUnit()->getIdentifier()->name();
+            const auto symbols = SymbolExporter::getSymbolFile(config_, path, name);
+            record->setSymbolFile(symbols, SymbolFile::readKey(symbols.string()));
+            for (const auto &import : ast->getImportedModules()) {
+                record->addImport(import->getPath(), import->getKey());
+            }
+            record->save();
+        }
     }
 }
 
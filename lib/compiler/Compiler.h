@@ -7,6 +7,7 @@
 
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 
 #include "Logger.h"
@@ -15,6 +16,7 @@
 #include "system/OberonSystem.h"
 #include "data/ast/ASTContext.h"
 
+using std::function;
 using std::unique_ptr;
 using std::filesystem::path;
 
@@ -25,7 +27,9 @@ public:
             config_(config), logger_(config.logger()), codegen_(codegen), system_(std::make_unique<Oberon07>()) {};
     ~Compiler() = default;
 
-    void compile(const path&);
+    // The optional callback is invoked as soon as the front-end is done with the module, i.e., after its
+    // symbol file has been written and before the back-end generates code.
+    void compile(const path&, const function<void()>& = nullptr);
 #ifndef _LLVM_LEGACY
     int jit(const path&);
 #endif
@@ -36,7 +40,9 @@ private:
     CodeGen *codegen_;
     unique_ptr<OberonSystem> system_;
 
+    // Reports a `CompilerError` that aborts the front-end and returns nothing in that case.
     unique_ptr<ASTContext> run(const path&);
+    unique_ptr<ASTContext> analyze(const path&);
 
 };
 
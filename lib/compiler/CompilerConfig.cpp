@@ -5,6 +5,18 @@
 #include "CompilerConfig.h"
 
 
+CompilerConfig::CompilerConfig(const CompilerConfig &other, ostream &out) :
+        logger_(other.logger_.getLevel(), out), infiles_(other.infiles_), outfile_(other.outfile_),
+        target_(other.target_), symboldir_(other.symboldir_), installdir_(other.installdir_),
+        workingdir_(other.workingdir_), std_(other.std_), type_(other.type_), level_(other.level_),
+        model_(other.model_), profile_(other.profile_), incdirs_(other.incdirs_), inc_search_paths_(other.inc_search_paths_),
+        libdirs_(other.libdirs_), libdircache_(other.libdircache_), libs_(other.libs_),
+        flags_(other.flags_), traps_(other.traps_), warn_(other.warn_), remarks_(other.remarks_),
+        jobs_(other.jobs_), partitions_(other.partitions_), threshold_(other.threshold_), jit_(other.jit_) {
+    logger_.setBanner(other.logger_.getBanner());
+    logger_.setWarnAsError(other.logger_.isWarnAsError());
+}
+
 Logger &CompilerConfig::logger() {
     return logger_;
 }
@@ -89,6 +101,14 @@ RelocationModel CompilerConfig::getRelocationModel() const {
     return model_;
 }
 
+void CompilerConfig::setProfileFile(const string &file) {
+    profile_ = file;
+}
+
+string CompilerConfig::getProfileFile() const {
+    return profile_;
+}
+
 optional<path> CompilerConfig::find(const path &name, const vector<path> &directories) {
     for (auto const &directory : directories) {
         const auto path = directory / name;
@@ -122,6 +142,13 @@ optional<path> CompilerConfig::findInclude(const path &name) {
     return find(name, inc_search_paths_);
 }
 
+const vector<path>& CompilerConfig::getIncludeDirectories() {
+    if (inc_search_paths_.empty()) {
+        buildCache(inc_search_paths_, incdirs_, "include");
+    }
+    return inc_search_paths_;
+}
+
 void CompilerConfig::addLibraryDirectory(const path &directory) {
     if (std::filesystem::exists(directory)) {
         libdirs_.push_back(directory);
@@ -136,6 +163,13 @@ optional<path> CompilerConfig::findLibrary(const path &name) {
     return find(name, libdircache_);
 }
 
+const vector<path>& CompilerConfig::getLibraryDirectories() {
+    if (libdircache_.empty()) {
+        buildCache(libdircache_, libdirs_, "lib");
+    }
+    return libdircache_;
+}
+
 void CompilerConfig::addLibrary(const string &name) {
     libs_.push_back(name);
 }
@@ -190,10 +224,42 @@ bool CompilerConfig::hasWarning(Warning warn) const {
     return warn_ & static_cast<unsigned>(warn);
 }
 
+void CompilerConfig::setRemark(Remark remark) {
+    remarks_ |= static_cast<unsigned>(remark);
+}
+
+bool CompilerConfig::hasRemark(Remark remark) const {
+    return remarks_ & static_cast<unsigned>(remark);
+}
+
 void CompilerConfig::setJit(const bool jit) {
     jit_ = jit;
 }
 
 bool CompilerConfig::isJit() const {
     return jit_;
-}
\ No newline at end of file
+}
+
+void CompilerConfig::setJobs(const unsigned jobs) {
+    jobs_ = jobs;
+}
+
+unsigned CompilerConfig::getJobs() const {
+    return jobs_;
+}
+
+void CompilerConfig::setPartitions(const unsigned partitions) {
+    partitions_ = partitions;
+}
+
+unsigned CompilerConfig::getPartitions() const {
+    return partitions_;
+}
+
+void CompilerConfig::setJitThreshold(const unsigned threshold) {
+    threshold_ = threshold;
+}
+
+unsigned CompilerConfig::getJitThreshold() const {
+    return threshold_;
+}
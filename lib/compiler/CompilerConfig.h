@@ -28,7 +28,7 @@ enum class LanguageStandard {
 };
 
 enum class OutputFileType {
-    AssemblyFile, BitCodeFile, LLVMIRFile, ObjectFile
+    AssemblyFile, BitCodeFile, LLVMIRFile, ObjectFile, ExecutableFile
 };
 
 enum class OptimizationLevel {
@@ -46,6 +46,13 @@ enum class Flag : uint8_t {
     STACK_PROTECT = 4,
     INIT_LOCAL_ZERO = 5,
     INIT_GLOBAL_ZERO = 6,
+    INCREMENTAL = 7,
+    POOL_ALLOCATOR = 8,
+    GARBAGE_COLLECT = 9,
+    DEFER_OVERFLOW = 10,
+    LTO = 11,
+    PROFILE_GENERATE = 12,
+    TIERED_JIT = 13,
 };
 
 enum class Trap : uint8_t {
@@ -66,12 +73,19 @@ enum class Warning : unsigned {
     ERROR = 1
 };
 
+enum class Remark : unsigned {
+    BOUNDS_CHECK = 1,
+    OVERFLOW_CHECK = 2
+};
+
 class CompilerConfig {
 
 public:
-    CompilerConfig() : logger_(LogLevel::INFO, cout), std_(LanguageStandard::TurboOberon),
+    CompilerConfig() : CompilerConfig(cout) {};
+    // Creates a configuration whose logger writes to the given stream.
+    explicit CompilerConfig(ostream &out) : logger_(LogLevel::INFO, out), std_(LanguageStandard::TurboOberon),
             type_(OutputFileType::ObjectFile), level_(OptimizationLevel::O0), model_(RelocationModel::DEFAULT),
-            warn_(0), jit_(false) {
+            warn_(0), remarks_(0), jobs_(1), partitions_(1), threshold_(1000), jit_(false) {
         // Activate default compiler flags
         setSanitizeAll();
         setFlag(Flag::INIT_GLOBAL_ZERO);
@@ -81,6 +95,8 @@ public:
         logger_.setLevel(LogLevel::DEBUG);
 #endif
     };
+    // Creates a copy of the given configuration whose logger writes to the given stream.
+    CompilerConfig(const CompilerConfig &, ostream &);
     CompilerConfig(const CompilerConfig &) = delete;
     CompilerConfig& operator=(CompilerConfig &) = delete;
     ~CompilerConfig() = default;
@@ -117,11 +133,17 @@ public:
     void setRelocationModel(RelocationModel);
     [[nodiscard]] RelocationModel getRelocationModel() const;
 
+    // Profile written by modules instrumented with `PROFILE_GENERATE`, or profile used to optimize the modules.
+    void setProfileFile(const string &);
+    [[nodiscard]] string getProfileFile() const;
+
     void addIncludeDirectory(const path &directory);
     [[nodiscard]] optional<path> findInclude(const path &);
+    [[nodiscard]] const vector<path>& getIncludeDirectories();
 
     void addLibraryDirectory(const path &directory);
     [[nodiscard]] optional<path> findLibrary(const path &);
+    [[nodiscard]] const vector<path>& getLibraryDirectories();
 
     void addLibrary(const string &);
     [[nodiscard]] const vector<string>& getLibraries() const;
@@ -138,6 +160,20 @@ public:
     void setWarning(Warning);
     [[nodiscard]] bool hasWarning(Warning) const;
 
+    void setRemark(Remark);
+    [[nodiscard]] bool hasRemark(Remark) const;
+
+    void setJobs(unsigned);
+    [[nodiscard]] unsigned getJobs() const;
+
+    // Number of partitions of a module whose code is generated in parallel.
+    void setPartitions(unsigned);
+    [[nodiscard]] unsigned getPartitions() const;
+
+    // Number of calls after which the tiered JIT recompiles a procedure with optimizations.
+    void setJitThreshold(unsigned);
+    [[nodiscard]] unsigned getJitThreshold() const;
+
     void setJit(bool jit);
     [[nodiscard]] bool isJit() const;
 
@@ -153,6 +189,7 @@ private:
     OutputFileType type_;
     OptimizationLevel level_;
     RelocationModel model_;
+    string profile_;
     vector<path> incdirs_;
     vector<path> inc_search_paths_;
     vector<path> libdirs_;
@@ -162,6 +199,10 @@ private:
     unordered_set<Trap> traps_;
 
     unsigned warn_;
+    unsigned remarks_;
+    unsigned jobs_;
+    unsigned partitions_;
+    unsigned threshold_;
     bool jit_;
 
     static std::optional<path> find(const path &, const vector<path> &);
@@ -0,0 +1,69 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#include "ThreadPool.h"
+
+using std::lock_guard;
+using std::unique_lock;
+
+ThreadPool::ThreadPool(const unsigned size) : active_(0), stop_(false) {
+    const unsigned count = size == 0 ? 1 : size;
+    workers_.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        workers_.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    available_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard lock(mutex_);
+        tasks_.push(std::move(task));
+    }
+    available_.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && active_ == 0; });
+}
+
+unsigned ThreadPool::size() const {
+    return static_cast<unsigned>(workers_.size());
+}
+
+void ThreadPool::work() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock lock(mutex_);
+            available_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                // Pool is shutting down and there is no more work
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+            ++active_;
+        }
+        task();
+        {
+            lock_guard lock(mutex_);
+            --active_;
+            if (tasks_.empty() && active_ == 0) {
+                idle_.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#ifndef OBERON_LANG_THREADPOOL_H
+#define OBERON_LANG_THREADPOOL_H
+
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using std::condition_variable;
+using std::function;
+using std::mutex;
+using std::queue;
+using std::thread;
+using std::vector;
+
+// Fixed-size pool of worker threads that execute tasks in the order in which they were submitted. Tasks may
+// submit further tasks to the pool they are running on.
+class ThreadPool {
+
+public:
+    explicit ThreadPool(unsigned);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool& operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    void submit(function<void()>);
+    // Blocks until all submitted tasks, including the ones submitted by running tasks, have completed.
+    void wait();
+
+    [[nodiscard]] unsigned size() const;
+
+private:
+    vector<thread> workers_;
+    queue<function<void()>> tasks_;
+    mutex mutex_;
+    condition_variable available_, idle_;
+    unsigned active_;
+    bool stop_;
+
+    void work();
+
+};
+
+
+#endif //OBERON_LANG_THREADPOOL_H
@@ -7,13 +7,17 @@
 #include <memory>
 
 using std::filesystem::path;
-using std::make_unique;
 
 const path &
 ASTContext::getSourceFileName() const {
     return file_;
 }
 
+const Arena &
+ASTContext::getArena() const {
+    return arena_;
+}
+
 ModuleNode *
 ASTContext::getTranslationUnit() const {
     return module_.get();
@@ -33,7 +37,7 @@ ASTContext::getOrInsertArrayType(const FilePos &start, const FilePos &,
         size *= length;
     }
     size *= types[types.size() - 1]->getSize();
-    auto type = make_unique<ArrayTypeNode>(start, dimensions, std::move(lengths), std::move(types));
+    auto type = make<ArrayTypeNode>(start, dimensions, std::move(lengths), std::move(types));
     type->setModule(module ? module : module_.get());
     type->setSize(size);
     const auto res = type.get();
@@ -45,7 +49,7 @@ ASTContext::getOrInsertArrayType(const FilePos &start, const FilePos &,
 RecordTypeNode *
 ASTContext::getOrInsertRecordType(const FilePos &start, const FilePos &,
                                   RecordTypeNode *base, vector<unique_ptr<FieldNode>> fields, ModuleNode *module) {
-    auto type = make_unique<RecordTypeNode>(start, base, std::move(fields));
+    auto type = make<RecordTypeNode>(start, base, std::move(fields));
     type->setModule(module ? module : module_.get());
     const auto res = type.get();
     record_ts_.push_back(std::move(type));
@@ -54,7 +58,7 @@ ASTContext::getOrInsertRecordType(const FilePos &start, const FilePos &,
 
 PointerTypeNode *
 ASTContext::getOrInsertPointerType(const FilePos &start, const FilePos &, TypeNode *base, ModuleNode *module) {
-    auto type = make_unique<PointerTypeNode>(start, base);
+    auto type = make<PointerTypeNode>(start, base);
     type->setModule(module ? module : module_.get());
     const auto res = type.get();
     pointer_ts_.push_back(std::move(type));
@@ -64,18 +68,71 @@ ASTContext::getOrInsertPointerType(const FilePos &start, const FilePos &, TypeNo
 ProcedureTypeNode *
 ASTContext::getOrInsertProcedureType(const FilePos &start, const FilePos &,
                                      vector<unique_ptr<ParameterNode>> params, bool varargs, TypeNode *ret, ModuleNode *module) {
-    auto type = make_unique<ProcedureTypeNode>(start, std::move(params), varargs, ret);
+    auto type = make<ProcedureTypeNode>(start, std::move(params), varargs, ret);
     type->setModule(module ? module : module_.get());
     const auto res = type.get();
     procedure_ts.push_back(std::move(type));
     return res;
 }
 
+// Returns the node registered for the given structure or registers the given type if there is none. A registered node
+// that was claimed by a type declaration in the meantime is replaced, as it is no longer anonymous.
+template<typename K, typename T>
+static T *intern(map<K, T *> &types, K key, T *type) {
+    auto [it, inserted] = types.try_emplace(std::move(key), type);
+    if (!inserted && !it->second->isAnonymous()) {
+        it->second = type;
+    }
+    return it->second;
+}
+
+TypeNode *
+ASTContext::getCanonicalType(TypeNode *type) {
+    if (!type || !type->isAnonymous()) {
+        return type;
+    }
+    if (type->isArray()) {
+        const auto array_t = dynamic_cast<ArrayTypeNode *>(type);
+        vector<TypeNode *> types;
+        for (const auto member : array_t->types()) {
+            types.push_back(getCanonicalType(member));
+        }
+        return intern(canonical_array_ts_, { type->getModule(), array_t->lengths(), std::move(types) }, array_t);
+    }
+    if (type->isPointer()) {
+        const auto pointer_t = dynamic_cast<PointerTypeNode *>(type);
+        const auto base = pointer_t->getBase();
+        if (!base || !base->isRecord()) {
+            // base type is still a forward reference
+            return type;
+        }
+        return intern(canonical_pointer_ts_, { type->getModule(), base }, pointer_t);
+    }
+    if (type->isProcedure()) {
+        const auto procedure_t = dynamic_cast<ProcedureTypeNode *>(type);
+        vector<pair<TypeNode *, bool>> params;
+        for (const auto &param : procedure_t->parameters()) {
+            params.emplace_back(getCanonicalType(param->getType()), param->isVar());
+        }
+        return intern(canonical_procedure_ts_, { type->getModule(), std::move(params), procedure_t->hasVarArgs(),
+                                                 getCanonicalType(procedure_t->getReturnType()) }, procedure_t);
+    }
+    return type;
+}
+
 void ASTContext::addExternalModule(std::unique_ptr<ModuleNode> module) {
     const string name = module->getIdentifier()->name();
     ext_modules_[name] = std::move(module);
 }
 
+void ASTContext::addImportedModule(shared_ptr<ImportedModule> module) {
+    imp_modules_.push_back(std::move(module));
+}
+
+const vector<shared_ptr<ImportedModule>> &ASTContext::getImportedModules() const {
+    return imp_modules_;
+}
+
 ModuleNode *ASTContext::getExternalModule(const std::string &name) {
     return ext_modules_[name].get();
 }
@@ -10,8 +10,11 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "Arena.h"
 #include "TypeNode.h"
 #include "ArrayTypeNode.h"
 #include "ModuleNode.h"
@@ -22,10 +25,15 @@
 
 using std::filesystem::path;
 using std::map;
+using std::pair;
+using std::shared_ptr;
 using std::string;
+using std::tuple;
 using std::unique_ptr;
 using std::vector;
 
+class ImportedModule;
+
 class ASTContext {
 
 public:
@@ -34,6 +42,13 @@ public:
 
     [[nodiscard]] const path &getSourceFileName() const;
 
+    // Node factory: allocates the node from the arena of this context, but the caller still owns it.
+    template<typename T, typename... Args>
+    unique_ptr<T> make(Args&&... args) {
+        return unique_ptr<T>(new (arena_) T(std::forward<Args>(args)...));
+    }
+    [[nodiscard]] const Arena &getArena() const;
+
     [[nodiscard]] ModuleNode *getTranslationUnit() const;
     void setTranslationUnit(unique_ptr<ModuleNode>);
 
@@ -45,22 +60,40 @@ public:
     ProcedureTypeNode *getOrInsertProcedureType(const FilePos &, const FilePos &,
                                                 vector<unique_ptr<ParameterNode>>, bool, TypeNode *, ModuleNode * = nullptr);
 
+    // Returns the canonical node of a type: anonymous array, pointer and procedure types of the same module that
+    // have the same structure are represented by the first such node that was looked up. Named types, record types,
+    // and pointer types with a not yet resolved base type are their own canonical node.
+    TypeNode *getCanonicalType(TypeNode *);
+
     // mainly for memory management as an anchor for smart pointers
     void addExternalModule(unique_ptr<ModuleNode> module);
     ModuleNode* getExternalModule(const string &name);
 
+    // keeps the declarations of a module imported through the import cache alive as long as this context
+    void addImportedModule(shared_ptr<ImportedModule> module);
+    [[nodiscard]] const vector<shared_ptr<ImportedModule>> &getImportedModules() const;
+
     void addExternalProcedure(ProcedureDeclarationNode *proc);
     [[nodiscard]] ProcedureDeclarationNode *getExternalProcedure(size_t num) const;
     [[nodiscard]] size_t getExternalProcedureCount() const;
 
 private:
+    // must be declared first, as it needs to outlive all nodes allocated from it
+    Arena arena_;
     path file_;
     unique_ptr<ModuleNode> module_;
     vector<unique_ptr<ArrayTypeNode>> array_ts_;
     vector<unique_ptr<RecordTypeNode>> record_ts_;
     vector<unique_ptr<PointerTypeNode>> pointer_ts_;
     vector<unique_ptr<ProcedureTypeNode>> procedure_ts;
+    using ArrayTypeKey = tuple<ModuleNode *, vector<unsigned>, vector<TypeNode *>>;
+    using PointerTypeKey = pair<ModuleNode *, TypeNode *>;
+    using ProcedureTypeKey = tuple<ModuleNode *, vector<pair<TypeNode *, bool>>, bool, TypeNode *>;
+    map<ArrayTypeKey, ArrayTypeNode *> canonical_array_ts_;
+    map<PointerTypeKey, PointerTypeNode *> canonical_pointer_ts_;
+    map<ProcedureTypeKey, ProcedureTypeNode *> canonical_procedure_ts_;
     map<string, unique_ptr<ModuleNode>> ext_modules_;
+    vector<shared_ptr<ImportedModule>> imp_modules_;
     vector<ProcedureDeclarationNode*> ext_procedures_;
 
 };
@@ -0,0 +1,70 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#include "Arena.h"
+
+#include <new>
+
+// Every object is preceded by a header that records the arena it was allocated from, if any.
+struct alignas(Arena::ALIGNMENT) ArenaHeader {
+    Arena *arena;
+};
+
+static size_t align(const size_t size) {
+    return (size + Arena::ALIGNMENT - 1) & ~(Arena::ALIGNMENT - 1);
+}
+
+Arena::~Arena() {
+    for (const auto block : blocks_) {
+        ::operator delete(block);
+    }
+}
+
+void *Arena::allocate(size_t size) {
+    size = align(size);
+    allocated_ += size;
+    if (size > static_cast<size_t>(end_ - ptr_)) {
+        if (size > blockSize_ / 4) {
+            // Large allocations get a block of their own so that the current block is not wasted
+            const auto block = ::operator new(size);
+            blocks_.push_back(block);
+            return block;
+        }
+        ptr_ = static_cast<char *>(::operator new(blockSize_));
+        end_ = ptr_ + blockSize_;
+        blocks_.push_back(ptr_);
+    }
+    const auto res = ptr_;
+    ptr_ += size;
+    return res;
+}
+
+size_t Arena::getAllocatedBytes() const {
+    return allocated_;
+}
+
+void *ArenaObject::operator new(const size_t size) {
+    const auto header = static_cast<ArenaHeader *>(::operator new(sizeof(ArenaHeader) + size));
+    header->arena = nullptr;
+    return header + 1;
+}
+
+void *ArenaObject::operator new(const size_t size, Arena &arena) {
+    const auto header = static_cast<ArenaHeader *>(arena.allocate(sizeof(ArenaHeader) + size));
+    header->arena = &arena;
+    return header + 1;
+}
+
+void ArenaObject::operator delete(void *ptr) {
+    if (ptr) {
+        const auto header = static_cast<ArenaHeader *>(ptr) - 1;
+        if (!header->arena) {
+            ::operator delete(header);
+        }
+    }
+}
+
+void ArenaObject::operator delete(void *, Arena &) {
+    // Memory of arena-allocated objects is reclaimed by the arena
+}
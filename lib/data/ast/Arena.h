@@ -0,0 +1,59 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#ifndef OBERON_LANG_ARENA_H
+#define OBERON_LANG_ARENA_H
+
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+/**
+ * Bump allocator that hands out memory from large blocks and releases all of it at once when it is destroyed.
+ * The AST context owns an arena, from which all nodes of a translation unit are allocated.
+ */
+class Arena {
+
+public:
+    explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE) : blockSize_(blockSize), ptr_(nullptr), end_(nullptr),
+            allocated_(0) {};
+    Arena(const Arena &) = delete;
+    Arena& operator=(const Arena &) = delete;
+    ~Arena();
+
+    // Returns memory of the given size that is suitably aligned for any object type.
+    void *allocate(size_t);
+
+    [[nodiscard]] size_t getAllocatedBytes() const;
+
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+private:
+    size_t blockSize_;
+    char *ptr_, *end_;
+    size_t allocated_;
+    vector<void *> blocks_;
+
+};
+
+/**
+ * Base class for objects that can either be allocated from an arena, using `new (arena) T(...)`, or from the heap,
+ * using `new T(...)`. Deleting an arena-allocated object only runs its destructor, the memory is reclaimed when the
+ * arena is destroyed. As a consequence, such objects can still be owned and moved by `std::unique_ptr`.
+ */
+class ArenaObject {
+
+public:
+    static void *operator new(size_t);
+    static void *operator new(size_t, Arena &);
+    static void operator delete(void *);
+    static void operator delete(void *, Arena &);
+
+};
+
+
+#endif //OBERON_LANG_ARENA_H
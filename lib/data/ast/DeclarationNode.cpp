@@ -70,7 +70,10 @@ TypeDeclarationNode::TypeDeclarationNode(const FilePos &pos, unique_ptr<IdentDef
 
 void TypeDeclarationNode::setModule(ModuleNode *module) {
     DeclarationNode::setModule(module);
-    this->getType()->setModule(module);
+    // only claim the type if it is declared by this declaration, e.g., not for `TYPE Int = INTEGER`
+    if (this->getType()->getDeclaration() == this) {
+        this->getType()->setModule(module);
+    }
 }
 
 void TypeDeclarationNode::accept(NodeVisitor& visitor) {
@@ -18,7 +18,7 @@ NodeType Selector::getNodeType() const {
 
 
 ArrayIndex::ArrayIndex(const FilePos &pos, std::vector<std::unique_ptr<ExpressionNode>> indices) :
-        Selector(NodeType::array_type, pos), indices_(std::move(indices)) { }
+        Selector(NodeType::array_type, pos), indices_(std::move(indices)), checks_() { }
 
 ArrayIndex::~ArrayIndex() = default;
 
@@ -26,6 +26,21 @@ vector<unique_ptr<ExpressionNode>> &ArrayIndex::indices() {
     return indices_;
 }
 
+void ArrayIndex::setCheck(const size_t num, const BoundsCheck check, ForLoopNode *guard) {
+    if (checks_.size() <= num) {
+        checks_.resize(num + 1, {BoundsCheck::REQUIRED, nullptr});
+    }
+    checks_[num] = {check, guard};
+}
+
+BoundsCheck ArrayIndex::getCheck(const size_t num) const {
+    return num < checks_.size() ? checks_[num].first : BoundsCheck::REQUIRED;
+}
+
+ForLoopNode *ArrayIndex::getGuard(const size_t num) const {
+    return num < checks_.size() ? checks_[num].second : nullptr;
+}
+
 
 RecordField::RecordField(const FilePos &pos, std::unique_ptr<Ident> ident) :
         Selector(NodeType::record_type, pos), ident_(std::move(ident)), field_() { }
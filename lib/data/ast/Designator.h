@@ -6,8 +6,10 @@
 #define OBERON_LANG_DESIGNATOR_H
 
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Ident.h"
@@ -15,10 +17,11 @@
 
 
 using std::make_unique;
+using std::pair;
 using std::unique_ptr;
 using std::vector;
 
-class Selector {
+class Selector : public ArenaObject {
 
 private:
     NodeType type_;
@@ -33,11 +36,17 @@ public:
 };
 
 class ExpressionNode;
+class ForLoopNode;
+
+// Out-of-bounds check of an array index: the check is either required, redundant as the index is always within
+// the bounds of the array, or guarded by a FOR loop that checks the bounds once before it is entered.
+enum class BoundsCheck : uint8_t { REQUIRED, REDUNDANT, GUARDED };
 
 class ArrayIndex final : public Selector {
 
 private:
     vector<unique_ptr<ExpressionNode>> indices_;
+    vector<pair<BoundsCheck, ForLoopNode *>> checks_;
 
 public:
     explicit ArrayIndex(const FilePos &pos, vector<unique_ptr<ExpressionNode>> indices);
@@ -45,6 +54,10 @@ public:
 
     [[nodiscard]] vector<unique_ptr<ExpressionNode>> &indices();
 
+    void setCheck(size_t, BoundsCheck, ForLoopNode * = nullptr);
+    [[nodiscard]] BoundsCheck getCheck(size_t) const;
+    [[nodiscard]] ForLoopNode *getGuard(size_t) const;
+
 };
 
 
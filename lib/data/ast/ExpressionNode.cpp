@@ -129,6 +129,14 @@ ExpressionNode *BinaryExpressionNode::getRightExpression() const {
     return rhs_.get();
 }
 
+void BinaryExpressionNode::setOverflow(const bool overflow) {
+    overflow_ = overflow;
+}
+
+bool BinaryExpressionNode::canOverflow() const {
+    return overflow_;
+}
+
 void BinaryExpressionNode::accept(NodeVisitor& visitor) {
     visitor.visit(*this);
 }
@@ -90,12 +90,13 @@ class BinaryExpressionNode final : public ExpressionNode {
 private:
     OperatorType op_;
     unique_ptr<ExpressionNode> lhs_, rhs_;
+    bool overflow_;
 
 public:
     BinaryExpressionNode(const FilePos &start, OperatorType op,
                          unique_ptr<ExpressionNode> lhs, unique_ptr<ExpressionNode> rhs, TypeNode *type) :
             ExpressionNode(NodeType::binary_expression, start, type),
-            op_(op), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {};
+            op_(op), lhs_(std::move(lhs)), rhs_(std::move(rhs)), overflow_(true) {};
     ~BinaryExpressionNode() final = default;
 
     [[nodiscard]] bool isConstant() const final;
@@ -105,6 +106,10 @@ public:
     [[nodiscard]] ExpressionNode *getLeftExpression() const;
     [[nodiscard]] ExpressionNode *getRightExpression() const;
 
+    // Integer arithmetic whose result is proven to be representable in its type is not checked for overflow.
+    void setOverflow(bool overflow);
+    [[nodiscard]] bool canOverflow() const;
+
     void accept(NodeVisitor &visitor) final;
 
     void print(std::ostream &stream) const final;
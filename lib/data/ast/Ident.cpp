@@ -14,16 +14,20 @@ FilePos Ident::end() const {
     return end_;
 }
 
-std::string Ident::name() const {
-    return name_;
+const std::string &Ident::name() const {
+    return Interner::name(symbol_);
+}
+
+Symbol Ident::symbol() const {
+    return symbol_;
 }
 
 void Ident::print(std::ostream &stream) const {
-    stream << name_ << (this->isExported() ? "*" : "");
+    stream << name() << (this->isExported() ? "*" : "");
 }
 
 bool Ident::equals(const Ident &other) const {
-    return this->name_ == other.name_;
+    return this->symbol_ == other.symbol_;
 }
 
 std::ostream& operator<<(std::ostream &stream, const Ident &ident) {
@@ -51,7 +55,11 @@ bool QualIdent::isQualified() const {
     return qualifier_.has_value();
 }
 
-std::string QualIdent::qualifier() const {
+const std::string &QualIdent::qualifier() const {
+    return Interner::name(qualifier_.value());
+}
+
+Symbol QualIdent::qualifierSymbol() const {
     return qualifier_.value();
 }
 
@@ -65,7 +73,7 @@ void QualIdent::print(std::ostream &stream) const {
 bool QualIdent::equals(const Ident &other) const {
     if (other.isQualified()) {
         if (this->isQualified()) {
-            return this->qualifier() == dynamic_cast<const QualIdent*>(&other)->qualifier();
+            return this->qualifier_ == dynamic_cast<const QualIdent*>(&other)->qualifier_;
         } else {
             return false;
         }
@@ -73,7 +81,7 @@ bool QualIdent::equals(const Ident &other) const {
         if (this->isQualified()) {
             return false;
         } else {
-            return this->name() == other.name();
+            return this->symbol() == other.symbol();
         }
     }
 }
@@ -7,6 +7,7 @@
 
 
 #include "global.h"
+#include "Interner.h"
 #include "Node.h"
 #include <optional>
 #include <string>
@@ -15,22 +16,27 @@
 using std::optional;
 using std::string;
 
-class Ident {
+class Ident : public ArenaObject {
 
 private:
     FilePos start_;
     FilePos end_;
-    string name_;
+    Symbol symbol_;
 
 public:
-    explicit Ident(string name) : start_(EMPTY_POS), end_(EMPTY_POS), name_(std::move(name)) {};
-    Ident(FilePos start, FilePos end, string name) : start_(std::move(start)), end_(std::move(end)), name_(std::move(name)) {};
-    explicit Ident(const Ident *ident) : start_(ident->start_), end_(ident->end_), name_(ident->name_) {};
+    explicit Ident(const string &name) : Ident(Interner::intern(name)) {};
+    explicit Ident(const Symbol symbol) : start_(EMPTY_POS), end_(EMPTY_POS), symbol_(symbol) {};
+    Ident(FilePos start, FilePos end, const string &name) :
+            Ident(std::move(start), std::move(end), Interner::intern(name)) {};
+    Ident(FilePos start, FilePos end, const Symbol symbol) :
+            start_(std::move(start)), end_(std::move(end)), symbol_(symbol) {};
+    explicit Ident(const Ident *ident) : start_(ident->start_), end_(ident->end_), symbol_(ident->symbol_) {};
     virtual ~Ident();
 
     [[nodiscard]] FilePos start() const;
     [[nodiscard]] FilePos end() const;
-    [[nodiscard]] string name() const;
+    [[nodiscard]] const string &name() const;
+    [[nodiscard]] Symbol symbol() const;
     [[nodiscard]] virtual bool isQualified() const { return false; };
     [[nodiscard]] virtual bool isExported() const { return false; };
 
@@ -53,6 +59,8 @@ public:
             Ident(name), exported_(exported) {};
     IdentDef(const FilePos &start, const FilePos &end, const string &name, bool exported = false) :
             Ident(start, end, name), exported_(exported) {};
+    IdentDef(const FilePos &start, const FilePos &end, const Symbol symbol, bool exported = false) :
+            Ident(start, end, symbol), exported_(exported) {};
     ~IdentDef() override;
 
     [[nodiscard]] bool isExported() const override;
@@ -62,27 +70,29 @@ public:
 class QualIdent final : public Ident {
 
 private:
-    optional<string> qualifier_;
-
-    explicit QualIdent(const FilePos &start, const FilePos &end,  optional<string> qualifier, const string &name) :
-            Ident(start, end, name), qualifier_(std::move(qualifier)) {};
+    optional<Symbol> qualifier_;
 
 public:
     explicit QualIdent(const string &name) :
             Ident(name), qualifier_(std::nullopt) {};
     explicit QualIdent(const string &qualifier, const string &name) :
-            Ident(name), qualifier_(optional<string>(qualifier)) {};
+            Ident(name), qualifier_(Interner::intern(qualifier)) {};
     explicit QualIdent(const FilePos &start, const FilePos &end, const string &name) :
             Ident(start, end, name), qualifier_(std::nullopt) {};
     explicit QualIdent(const FilePos &start, const FilePos &end, const string &qualifier, const string &name) :
-            Ident(start, end, name), qualifier_(optional<string>(std::move(qualifier))) {};
+            Ident(start, end, name), qualifier_(Interner::intern(qualifier)) {};
+    explicit QualIdent(const FilePos &start, const FilePos &end, const Symbol name) :
+            Ident(start, end, name), qualifier_(std::nullopt) {};
+    explicit QualIdent(const FilePos &start, const FilePos &end, const Symbol qualifier, const Symbol name) :
+            Ident(start, end, name), qualifier_(qualifier) {};
     explicit QualIdent(Ident *ident) :
             Ident(ident), qualifier_(ident->isQualified() ? dynamic_cast<QualIdent *>(ident)->qualifier_ : std::nullopt) {};
     ~QualIdent() override;
 
     [[nodiscard]] bool isQualified() const override;
 
-    [[nodiscard]] string qualifier() const;
+    [[nodiscard]] const string &qualifier() const;
+    [[nodiscard]] Symbol qualifierSymbol() const;
 
     void print(std::ostream &stream) const override;
     [[nodiscard]] bool equals(const Ident &other) const override;
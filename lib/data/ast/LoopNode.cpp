@@ -98,6 +98,18 @@ ExpressionNode * ForLoopNode::getStep() const {
     return step_.get();
 }
 
+vector<LoopGuard> &ForLoopNode::guards() {
+    return guards_;
+}
+
+void ForLoopNode::setDeferredOverflow(const bool deferred) {
+    deferred_ = deferred;
+}
+
+bool ForLoopNode::hasDeferredOverflow() const {
+    return deferred_;
+}
+
 void ForLoopNode::accept(NodeVisitor& visitor) {
     visitor.visit(*this);
 }
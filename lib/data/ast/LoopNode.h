@@ -8,7 +8,9 @@
 #define OBERON0C_LOOPNODE_H
 
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "AssignmentNode.h"
 #include "ExpressionNode.h"
@@ -18,6 +20,9 @@
 using std::make_unique;
 using std::ostream;
 using std::unique_ptr;
+using std::vector;
+
+class ArrayTypeNode;
 
 class LoopNode : public StatementNode {
 
@@ -99,18 +104,32 @@ public:
 
 };
 
+// Bounds check that a FOR loop performs once before it is entered for the array indices guarded by the loop.
+// The index is either the counter of the loop, a variable that the loop does not modify, or a constant (nullptr).
+// The offsets are the smallest and largest constant that the guarded array indices add to the index.
+struct LoopGuard {
+    QualifiedExpression *index;
+    int64_t lower, upper;
+    ArrayTypeNode *array;
+    DeclarationNode *decl;  // open array whose length bounds the index
+    uint32_t dimension;
+};
+
 class ForLoopNode final : public LoopNode {
 
 private:
     unique_ptr<QualifiedExpression> counter_;
     unique_ptr<ExpressionNode> low_, high_, step_;
+    vector<LoopGuard> guards_;
+    bool deferred_;
 
 public:
     ForLoopNode(const FilePos &pos, unique_ptr<QualifiedExpression> counter,
                 unique_ptr<ExpressionNode> low, unique_ptr<ExpressionNode> high, unique_ptr<ExpressionNode> step,
                 unique_ptr<StatementSequenceNode> stmts) :
             LoopNode(NodeType::for_loop, pos, std::move(stmts)),
-            counter_(std::move(counter)), low_(std::move(low)), high_(std::move(high)), step_(std::move(step)) { };
+            counter_(std::move(counter)), low_(std::move(low)), high_(std::move(high)), step_(std::move(step)),
+            guards_(), deferred_(false) { };
     ~ForLoopNode() final = default;
 
     [[nodiscard]] QualifiedExpression *getCounter() const;
@@ -118,6 +137,12 @@ public:
     [[nodiscard]] ExpressionNode *getHigh() const;
     [[nodiscard]] ExpressionNode *getStep() const;
 
+    [[nodiscard]] vector<LoopGuard> &guards();
+
+    // The overflow checks of the loop body are combined into a flag that is checked once the loop is exited.
+    void setDeferredOverflow(bool deferred);
+    [[nodiscard]] bool hasDeferredOverflow() const;
+
     void accept(NodeVisitor& visitor) final;
 
     void print(ostream &stream) const final;
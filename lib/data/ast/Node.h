@@ -9,6 +9,7 @@
 
 
 #include "global.h"
+#include "Arena.h"
 #include <list>
 #include <memory>
 #include <ostream>
@@ -29,7 +30,7 @@ enum class NodeType : char {
 
 class NodeVisitor;
 
-class Node {
+class Node : public ArenaObject {
 
 private:
     NodeType nodeType_;
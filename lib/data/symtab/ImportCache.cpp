@@ -0,0 +1,119 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#include "ImportCache.h"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#include "SymbolFile.h"
+
+using std::lock_guard;
+using std::make_shared;
+using std::string;
+
+ImportedModule::ImportedModule(CompilerConfig &config, const path &file, const string &name,
+                               const file_time_type time, const int64_t key) :
+        path_(file), name_(name), time_(time), key_(key), log_(), config_(config, log_), context_(file),
+        system_(), importer_(config_, context_, system_), module_(), loaded_(false) {}
+
+ImportedModule::~ImportedModule() = default;
+
+bool ImportedModule::load(Logger &logger) {
+    lock_guard lock(mutex_);
+    if (!loaded_) {
+        importer_.setLogger(logger);
+        module_ = importer_.readSymbolFile(path_, name_);
+        importer_.setLogger(config_.logger());
+        loaded_ = true;
+    }
+    return module_ != nullptr;
+}
+
+ModuleNode *ImportedModule::getModule() const {
+    return module_;
+}
+
+const path &ImportedModule::getPath() const {
+    return path_;
+}
+
+int64_t ImportedModule::getKey() const {
+    return key_;
+}
+
+bool ImportedModule::isCurrent(const file_time_type time, const int64_t key) const {
+    return time_ == time && key_ == key;
+}
+
+DeclarationNode *ImportedModule::lookup(Logger &logger, const string &name) {
+    lock_guard lock(mutex_);
+    importer_.setLogger(logger);
+    const auto decl = system_.getSymbolTable()->lookup(name_, name);
+    importer_.setLogger(config_.logger());
+    return decl;
+}
+
+void ImportedModule::declarations(const function<void(const string &, DeclarationNode *)> &fun) {
+    lock_guard lock(mutex_);
+    if (!module_) {
+        return;
+    }
+    for (const auto &decl : module_->constants()) {
+        fun(decl->getIdentifier()->name(), decl.get());
+    }
+    for (const auto &decl : module_->types()) {
+        fun(decl->getIdentifier()->name(), decl.get());
+    }
+    for (const auto &decl : module_->variables()) {
+        fun(decl->getIdentifier()->name(), decl.get());
+    }
+    for (const auto &decl : module_->procedures()) {
+        fun(decl->getIdentifier()->name(), decl.get());
+    }
+}
+
+
+ImportCache &ImportCache::instance() {
+    static ImportCache cache;
+    return cache;
+}
+
+shared_ptr<ImportedModule> ImportCache::get(CompilerConfig &config, const path &file, const string &name,
+                                            Logger &logger) {
+    std::error_code ec;
+    auto fp = std::filesystem::weakly_canonical(file, ec);
+    if (ec) {
+        fp = file;
+    }
+    const auto time = std::filesystem::last_write_time(fp, ec);
+    const auto key = SymbolFile::readKey(fp.string());
+    shared_ptr<ImportedModule> entry;
+    {
+        lock_guard lock(mutex_);
+        auto &slot = entries_[fp];
+        if (!slot || !slot->isCurrent(time, key)) {
+            logger.debug("Import cache miss: '" + fp.string() + "'.");
+            slot = make_shared<ImportedModule>(config, fp, name, time, key);
+        }
+        entry = slot;
+    }
+    // the symbol file is read outside the lock of the cache, so that different modules can be read concurrently
+    if (!entry->load(logger)) {
+        lock_guard lock(mutex_);
+        if (const auto it = entries_.find(fp); it != entries_.end() && it->second == entry) {
+            entries_.erase(it);
+        }
+        return nullptr;
+    }
+    return entry;
+}
+
+void ImportCache::clear() {
+    lock_guard lock(mutex_);
+    entries_.clear();
+}
@@ -0,0 +1,100 @@
+//
+// Created by Michael Grossniklaus on 10/17/26.
+//
+
+#ifndef OBERON_LANG_IMPORTCACHE_H
+#define OBERON_LANG_IMPORTCACHE_H
+
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "Logger.h"
+#include "SymbolImporter.h"
+#include "compiler/CompilerConfig.h"
+#include "data/ast/ASTContext.h"
+#include "data/ast/DeclarationNode.h"
+#include "data/ast/ModuleNode.h"
+#include "system/OberonSystem.h"
+
+using std::filesystem::file_time_type;
+using std::filesystem::path;
+using std::function;
+using std::map;
+using std::mutex;
+using std::ostringstream;
+using std::shared_ptr;
+using std::string;
+using std::unique_ptr;
+
+// An imported module as read from its symbol file. The declarations of the module are owned by the entry and are
+// shared by all compilations that import the module, hence they must never be modified after they have been loaded.
+// Declarations that are loaded lazily are read under the lock of the entry.
+class ImportedModule {
+
+public:
+    ImportedModule(CompilerConfig &config, const path &file, const string &name, file_time_type time, int64_t key);
+    ImportedModule(const ImportedModule &) = delete;
+    ImportedModule& operator=(const ImportedModule &) = delete;
+    ~ImportedModule();
+
+    // Reads the symbol file and reports errors to the given logger, returns false if the module could not be read.
+    bool load(Logger &);
+
+    [[nodiscard]] ModuleNode *getModule() const;
+    [[nodiscard]] const path &getPath() const;
+    [[nodiscard]] int64_t getKey() const;
+    [[nodiscard]] bool isCurrent(file_time_type, int64_t) const;
+
+    // Looks up a declaration, loading it from the symbol file if it has not been loaded yet.
+    DeclarationNode *lookup(Logger &, const string &);
+    // Calls the function for each declaration that has already been loaded.
+    void declarations(const function<void(const string &, DeclarationNode *)> &);
+
+private:
+    mutex mutex_;
+    path path_;
+    string name_;
+    file_time_type time_;
+    int64_t key_;
+    ostringstream log_;
+    CompilerConfig config_;
+    ASTContext context_;
+    Oberon07 system_;
+    SymbolImporter importer_;
+    ModuleNode *module_;
+    bool loaded_;
+
+};
+
+
+// Process-wide cache of imported modules, keyed by the path of their symbol file. An entry is reused as long as the
+// modification time and the key of the symbol file have not changed.
+class ImportCache {
+
+public:
+    static ImportCache &instance();
+
+    // Returns the entry of the symbol file, reading it if it has not been cached yet or if it has changed since.
+    // Errors that occur while reading the symbol file are reported to the given logger.
+    shared_ptr<ImportedModule> get(CompilerConfig &, const path &, const string &, Logger &);
+
+    // Removes all entries, compilations that still use an entry keep it alive.
+    void clear();
+
+private:
+    ImportCache() = default;
+
+    mutex mutex_;
+    map<path, shared_ptr<ImportedModule>> entries_;
+
+};
+
+
+#endif //OBERON_LANG_IMPORTCACHE_H
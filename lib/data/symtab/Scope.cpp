@@ -22,13 +22,13 @@ Scope *Scope::getChild() const {
     return child_.get();
 }
 
-void Scope::insert(const std::string &name, DeclarationNode *symbol) {
+void Scope::insert(const Symbol name, DeclarationNode *symbol) {
     symbols_.push_back(symbol);
     auto idx = symbols_.size() - 1;
     indices_.insert(std::make_pair(name, idx));
 }
 
-DeclarationNode *Scope::lookup(const std::string &name, const bool local) const {
+DeclarationNode *Scope::lookup(const Symbol name, const bool local) const {
     auto itr = indices_.find(name);
     if (itr != indices_.end()) {
         const auto idx = itr->second;
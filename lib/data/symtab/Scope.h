@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "Interner.h"
 #include "data/ast/DeclarationNode.h"
 
 using std::string;
@@ -31,15 +32,15 @@ public:
     void setChild(std::unique_ptr<Scope> child);
     [[nodiscard]] Scope *getChild() const;
 
-    void insert(const std::string &name, DeclarationNode *symbol);
-    [[nodiscard]] DeclarationNode *lookup(const std::string &name, bool local) const;
+    void insert(Symbol name, DeclarationNode *symbol);
+    [[nodiscard]] DeclarationNode *lookup(Symbol name, bool local) const;
 
     void getExportedSymbols(std::vector<DeclarationNode*> &exports) const;
 
 private:
     const unsigned int level_;
     vector<DeclarationNode *> symbols_;
-    unordered_map<string, size_t> indices_;
+    unordered_map<Symbol, size_t> indices_;
     std::unique_ptr<Scope> child_;
     Scope *parent_;
 
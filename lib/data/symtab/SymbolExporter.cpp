@@ -4,22 +4,29 @@
 
 #include "SymbolExporter.h"
 
-using std::filesystem::path;
+#include <algorithm>
+#include <vector>
 
-void SymbolExporter::write(const std::string &name, SymbolTable *symbols) {
-    xref_ = static_cast<int>(TypeKind::TYPE) + 1;
+using std::vector;
+
+path SymbolExporter::getSymbolFile(CompilerConfig &config, const path &source, const std::string &name) {
     path pth;
-    auto symdir = config_.getSymbolDirectory();
+    auto symdir = config.getSymbolDirectory();
     if (symdir.empty()) {
-        pth = context_.getSourceFileName().parent_path();
+        pth = source.parent_path();
     } else {
         pth = symdir;
     }
-    const auto fp = (pth / name).replace_extension(".smb");
+    return (pth / name).replace_extension(".smb");
+}
+
+void SymbolExporter::write(const std::string &name, SymbolTable *symbols) {
+    xref_ = static_cast<int>(TypeKind::TYPE) + 1;
+    const auto fp = getSymbolFile(config_, context_.getSourceFileName(), name);
     const auto file = std::make_unique<SymbolFile>();
     file->open(fp.string(), std::ios::out);
     // write symbol file header
-    file->writeLong(0); // placeholder, inserted at the end
+    file->writeLong(0); // placeholder for the key, inserted at the end
     file->writeString(name + ".Mod");
     file->writeChar(SymbolFile::VERSION);
 #ifdef _DEBUG
@@ -32,9 +39,40 @@ void SymbolExporter::write(const std::string &name, SymbolTable *symbols) {
     // get exported symbols from the module scope
     std::vector<DeclarationNode *> exports;
     scope->getExportedSymbols(exports);
-    // write out exported symbols to file
-    for (const auto decl: exports) {
-        writeDeclaration(file.get(), decl);
+    // type declarations are written out first, as they are read eagerly by the importer
+    const auto types = std::stable_partition(exports.begin(), exports.end(), [](const DeclarationNode *decl) {
+        return decl->getNodeType() == NodeType::type;
+    });
+    // write out index of all other declarations, which are read lazily by the importer
+    file->writeInt(static_cast<int>(exports.end() - types));
+    vector<size_t> offsets;
+    for (auto it = types; it != exports.end(); ++it) {
+        file->writeString((*it)->getIdentifier()->name());
+        offsets.push_back(file->tell());
+        file->writeInt(0); // placeholder, inserted once the declaration has been written out
+    }
+    // write out exported type declarations
+    for (auto it = exports.begin(); it != types; ++it) {
+        writeDeclaration(file.get(), *it);
+#ifdef _DEBUG
+        std::cout << std::endl;
+#endif
+    }
+    // write out terminator
+    file->writeChar(0);
+    writeForwardTypes(file.get());
+    // write out all other exported declarations: each of them can only refer to the types written out so far
+    // and to the types that it writes out itself
+    const auto xref = xref_;
+    const auto xrefs = xrefs_;
+    const auto fwds = fwds_;
+    for (auto it = types; it != exports.end(); ++it) {
+        file->patchInt(offsets[static_cast<size_t>(it - types)], static_cast<int>(file->tell()));
+        xref_ = xref;
+        xrefs_ = xrefs;
+        fwds_ = fwds;
+        writeDeclaration(file.get(), *it);
+        writeForwardTypes(file.get());
 #ifdef _DEBUG
         std::cout << std::endl;
 #endif
@@ -44,11 +82,32 @@ void SymbolExporter::write(const std::string &name, SymbolTable *symbols) {
 #ifdef _DEBUG
     std::cout << std::endl;
 #endif
+    // the key identifies the interface of the module: it only changes if the rest of the symbol file changes
+    file->patchLong(0, file->checksum(sizeof(int64_t)));
     // flush and close file
     file->flush();
     file->close();
 }
 
+void SymbolExporter::writeForwardTypes(SymbolFile *file) {
+    // write out the types that have been forward-referenced by pointer types, but not yet been written out
+    while (true) {
+        TypeNode *next = nullptr;
+        for (const auto &[type, ref] : fwds_) {
+            if (!xrefs_.contains(type) && (!next || ref < fwds_[next])) {
+                next = type;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        file->writeChar(1);
+        writeType(file, next);
+    }
+    // write out terminator
+    file->writeChar(0);
+}
+
 void SymbolExporter::writeDeclaration(SymbolFile *file, DeclarationNode *decl) {
     // write out declaration node type
     auto nodeType = decl->getNodeType();
@@ -134,13 +193,10 @@ void SymbolExporter::writeType(SymbolFile *file, TypeNode *type) {
             xrefs_[type] = xref_;
             xref_++;
         }
-        if (isExternal(type)) {
-            const auto decl = type->getDeclaration();
-            file->writeString(decl->getModule()->getIdentifier()->name());
-            file->writeString(decl->getIdentifier()->name());
-        } else {
-            file->writeString("");
-        }
+        // write out the qualified name of the type, as a type can be written out more than once
+        const auto decl = type->getDeclaration();
+        file->writeString(decl->getModule()->getIdentifier()->name());
+        file->writeString(decl->getIdentifier()->name());
     }
     file->writeChar(static_cast<signed char>(type->kind()));
     switch (type->kind()) {
@@ -6,6 +6,7 @@
 #define OBERON_LANG_SYMBOLEXPORTER_H
 
 
+#include <filesystem>
 #include <map>
 
 #include "Logger.h"
@@ -17,6 +18,7 @@
 #include "data/ast/ProcedureTypeNode.h"
 #include "data/ast/RecordTypeNode.h"
 
+using std::filesystem::path;
 using std::map;
 
 class SymbolExporter {
@@ -28,6 +30,9 @@ public:
 
     void write(const std::string &, SymbolTable *);
 
+    // Returns the path of the symbol file that is written for the given module.
+    [[nodiscard]] static path getSymbolFile(CompilerConfig &, const path &, const std::string &);
+
 private:
     CompilerConfig &config_;
     ASTContext &context_;
@@ -39,6 +44,7 @@ private:
     map<TypeNode *, unsigned> fwds_;
 
     void writeDeclaration(SymbolFile *, DeclarationNode *);
+    void writeForwardTypes(SymbolFile *);
     void writeType(SymbolFile *, TypeNode *);
     void writeArrayType(SymbolFile *, const ArrayTypeNode *);
     void writePointerType(SymbolFile *, const PointerTypeNode *);
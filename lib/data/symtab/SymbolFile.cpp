@@ -2,21 +2,79 @@
 // Created by Michael Grossniklaus on 3/19/22.
 //
 
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include "SymbolFile.h"
 
+#ifndef _WINAPI
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SymbolFile::~SymbolFile() {
+    close();
+}
+
 void SymbolFile::open(const std::string &path, std::ios::openmode mode) {
-    file_.open(path, mode | std::ios::binary);
+    close();
     path_ = path;
+    if (mode & std::ios::out) {
+        writing_ = true;
+    } else {
+        load();
+    }
+}
+
+void SymbolFile::load() {
+#ifndef _WINAPI
+    if (const int fd = ::open(path_.c_str(), O_RDONLY); fd >= 0) {
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            const auto size = static_cast<size_t>(st.st_size);
+            if (void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); addr != MAP_FAILED) {
+                buf_ = static_cast<const char *>(addr);
+                size_ = size;
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+        if (mapped_) {
+            return;
+        }
+    }
+#endif
+    // Fall back to reading the whole file into memory
+    std::ifstream file(path_, std::ios::in | std::ios::binary);
+    data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    buf_ = data_.data();
+    size_ = data_.size();
 }
 
 std::string SymbolFile::path() const {
     return path_;
 }
 
+void SymbolFile::read(void *val, const size_t len) {
+    if (len > size_ - pos_) {
+        eof_ = true;
+        pos_ = size_;
+        return;
+    }
+    std::memcpy(val, buf_ + pos_, len);
+    pos_ += len;
+}
+
+void SymbolFile::write(const void *val, const size_t len) {
+    data_.append(static_cast<const char *>(val), len);
+}
+
 int8_t SymbolFile::readChar() {
     int8_t val = 0;
-    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    read(&val, sizeof(val));
 #ifdef _DEBUG
     std::cout << static_cast<int>(val) << "c|";
 #endif
@@ -27,12 +85,12 @@ void SymbolFile::writeChar(const int8_t val) {
 #ifdef _DEBUG
     std::cout << static_cast<int>(val) << "c|";
 #endif
-    file_.write(reinterpret_cast<const char *>(&val), sizeof(val));
+    write(&val, sizeof(val));
 }
 
 int16_t SymbolFile::readShort() {
     int16_t val = 0;
-    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    read(&val, sizeof(val));
 #ifdef _DEBUG
     std::cout << val << "s|";
 #endif
@@ -43,12 +101,12 @@ void SymbolFile::writeShort(const int16_t val) {
 #ifdef _DEBUG
     std::cout << val << "s|";
 #endif
-    file_.write(reinterpret_cast<const char *>(&val), sizeof(val));
+    write(&val, sizeof(val));
 }
 
 int32_t SymbolFile::readInt() {
     int32_t val = 0;
-    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    read(&val, sizeof(val));
 #ifdef _DEBUG
     std::cout << val << "i|";
 #endif
@@ -59,12 +117,12 @@ void SymbolFile::writeInt(const int32_t val) {
 #ifdef _DEBUG
     std::cout << val << "i|";
 #endif
-    file_.write(reinterpret_cast<const char *>(&val), sizeof(val));
+    write(&val, sizeof(val));
 }
 
 int64_t SymbolFile::readLong() {
     int64_t val = 0;
-    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    read(&val, sizeof(val));
 #ifdef _DEBUG
     std::cout << val << "l|";
 #endif
@@ -75,12 +133,12 @@ void SymbolFile::writeLong(const int64_t val) {
 #ifdef _DEBUG
     std::cout << val << "l|";
 #endif
-    file_.write(reinterpret_cast<const char*>(&val), sizeof(val));
+    write(&val, sizeof(val));
 }
 
 float SymbolFile::readFloat() {
     float val = 0.0;
-    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    read(&val, sizeof(val));
 #ifdef _DEBUG
     std::cout << val << "f|";
 #endif
@@ -91,12 +149,12 @@ void SymbolFile::writeFloat(const float val) {
 #ifdef _DEBUG
     std::cout << val << "f|";
 #endif
-    file_.write(reinterpret_cast<const char*>(&val), sizeof(val));
+    write(&val, sizeof(val));
 }
 
 double SymbolFile::readDouble() {
     double val = 0.0;
-    file_.read(reinterpret_cast<char *>(&val), sizeof(val));
+    read(&val, sizeof(val));
 #ifdef _DEBUG
     std::cout << val << "d|";
 #endif
@@ -107,19 +165,24 @@ void SymbolFile::writeDouble(const double val) {
 #ifdef _DEBUG
     std::cout << val << "d|";
 #endif
-    file_.write(reinterpret_cast<const char*>(&val), sizeof(val));
+    write(&val, sizeof(val));
 }
 
 std::string SymbolFile::readString() {
     unsigned long len = 0;
-    file_.read(reinterpret_cast<char *>(&len), sizeof(len));
+    read(&len, sizeof(len));
 #ifdef _DEBUG
     std::cout << len << ":";
 #endif
-    const auto buffer = new char[len];
-    file_.read(buffer, static_cast<long>(len));
-    auto val = std::string(buffer, len);
-    delete[] buffer;
+    std::string val;
+    if (len <= size_ - pos_) {
+        // construct the string directly from the mapped file
+        val.assign(buf_ + pos_, len);
+        pos_ += len;
+    } else {
+        eof_ = true;
+        pos_ = size_;
+    }
 #ifdef _DEBUG
     std::cout << (val.empty() ? "0X" : val) << "|";
 #endif
@@ -131,21 +194,113 @@ void SymbolFile::writeString(const std::string &val) {
 #ifdef _DEBUG
     std::cout << len << ":";
 #endif
-    file_.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    write(&len, sizeof(len));
 #ifdef _DEBUG
     std::cout << (val.empty() ? "0X" : val) << "|";
 #endif
-    file_.write(val.c_str(), static_cast<long>(len));
+    write(val.data(), len);
+}
+
+void SymbolFile::patchInt(const size_t pos, const int32_t val) {
+    if (pos + sizeof(val) <= data_.size()) {
+        std::memcpy(data_.data() + pos, &val, sizeof(val));
+    }
+}
+
+void SymbolFile::patchLong(const size_t pos, const int64_t val) {
+    if (pos + sizeof(val) <= data_.size()) {
+        std::memcpy(data_.data() + pos, &val, sizeof(val));
+    }
+}
+
+int64_t SymbolFile::checksum(const size_t pos) const {
+    return pos < data_.size() ? checksum(data_.data() + pos, data_.size() - pos) : checksum(nullptr, 0);
+}
+
+int64_t SymbolFile::checksum(const char *data, const size_t len) {
+    // 64-bit FNV-1a hash
+    uint64_t hash = 0xcbf29ce484222325;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3;
+    }
+    return static_cast<int64_t>(hash);
+}
+
+int64_t SymbolFile::readKey(const string &path) {
+    int64_t key = 0;
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    file.read(reinterpret_cast<char *>(&key), sizeof(key));
+    return file ? key : 0;
+}
+
+size_t SymbolFile::tell() const {
+    return writing_ ? data_.size() : pos_;
+}
+
+void SymbolFile::seek(const size_t pos) {
+    eof_ = pos > size_;
+    pos_ = eof_ ? size_ : pos;
 }
 
 bool SymbolFile::eof() const {
-    return file_.eof();
+    return eof_;
 }
 
 void SymbolFile::flush() {
-    file_.flush();
+    if (writing_) {
+        std::ifstream in(path_, std::ios::in | std::ios::binary | std::ios::ate);
+        if (in && static_cast<size_t>(in.tellg()) == data_.size()) {
+            string old(data_.size(), '\0');
+            in.seekg(0);
+            in.read(old.data(), static_cast<std::streamsize>(old.size()));
+            if (in && old == data_) {
+                return;
+            }
+        }
+        in.close();
+        // The symbol file is replaced instead of truncated, as it might still be mapped by the import cache of this or
+        // another compiler process, which would read beyond the end of a truncated mapping.
+#ifndef _WINAPI
+        string tmp = path_ + ".XXXXXX";
+        const int fd = mkstemp(tmp.data());
+        if (fd < 0) {
+            return;
+        }
+        bool valid = fchmod(fd, 0644) == 0;
+        for (size_t pos = 0; valid && pos < data_.size();) {
+            const auto len = ::write(fd, data_.data() + pos, data_.size() - pos);
+            valid = len > 0;
+            pos += valid ? static_cast<size_t>(len) : 0;
+        }
+        valid = ::close(fd) == 0 && valid;
+        if (!valid || ::rename(tmp.c_str(), path_.c_str()) != 0) {
+            ::unlink(tmp.c_str());
+        }
+#else
+        const string tmp = path_ + ".tmp";
+        std::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(data_.data(), static_cast<std::streamsize>(data_.size()));
+        file.close();
+        std::error_code ec;
+        if (file) {
+            std::filesystem::rename(tmp, path_, ec);
+        }
+        if (!file || ec) {
+            std::filesystem::remove(tmp, ec);
+        }
+#endif
+    }
 }
 
 void SymbolFile::close() {
-    file_.close();
-}
\ No newline at end of file
+#ifndef _WINAPI
+    if (mapped_) {
+        munmap(const_cast<char *>(buf_), size_);
+    }
+#endif
+    data_.clear();
+    buf_ = nullptr;
+    size_ = pos_ = 0;
+    mapped_ = writing_ = eof_ = false;
+}
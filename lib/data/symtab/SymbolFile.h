@@ -10,14 +10,21 @@
 #include <fstream>
 #include <string>
 
-using std::fstream;
 using std::string;
 
+/**
+ * Binary symbol file. Symbol files are memory-mapped for reading, so that the importer can jump to the declarations
+ * listed in the index of the file. For writing, the contents are buffered in memory, which makes it possible to patch
+ * offsets into the index once the declarations have been written, and written to disk when the file is flushed.
+ * A symbol file whose contents have not changed is not written again, so that its modification time is preserved.
+ */
 class SymbolFile {
 
 public:
-    SymbolFile() = default;
-    ~SymbolFile() = default;
+    SymbolFile() : buf_(nullptr), size_(0), pos_(0), mapped_(false), writing_(false), eof_(false) {};
+    SymbolFile(const SymbolFile &) = delete;
+    SymbolFile& operator=(const SymbolFile &) = delete;
+    ~SymbolFile();
 
     void open(const string &path, std::ios::openmode mode);
     [[nodiscard]] string path() const;
@@ -38,15 +45,35 @@ public:
     void writeDouble(double val);
     void writeString(const std::string &val);
 
+    // Overwrites a previously written integer, e.g., to fill in the offsets of the index.
+    void patchInt(size_t pos, int32_t val);
+    void patchLong(size_t pos, int64_t val);
+
+    // Computes a checksum of the contents written so far, starting at the given position.
+    [[nodiscard]] int64_t checksum(size_t pos) const;
+    [[nodiscard]] static int64_t checksum(const char *, size_t);
+    // Reads the key from the header of a symbol file without loading the rest of it.
+    [[nodiscard]] static int64_t readKey(const string &path);
+
+    [[nodiscard]] size_t tell() const;
+    void seek(size_t pos);
+
     [[nodiscard]] bool eof() const;
     void flush();
     void close();
 
-    static constexpr uint32_t VERSION = 5;
+    static constexpr uint32_t VERSION = 6;
 
 private:
-    fstream file_;
     string path_;
+    const char *buf_;
+    size_t size_, pos_;
+    string data_;
+    bool mapped_, writing_, eof_;
+
+    void load();
+    void read(void *, size_t);
+    void write(const void *, size_t);
 
 };
 
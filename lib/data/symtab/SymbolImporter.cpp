@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 
+#include "ImportCache.h"
+#include "Interner.h"
 #include "SymbolFile.h"
 #include "data/ast/NodePrettyPrinter.h"
 
@@ -22,17 +24,40 @@ ModuleNode *SymbolImporter::read(const string &name) {
     auto fp = (path / name).replace_extension(".smb");
     const auto include = fp.filename();
     if (!std::filesystem::exists(fp)) {
-        logger_.debug("Symbol file not found: '" + fp.string() + "'.");
+        logger_->debug("Symbol file not found: '" + fp.string() + "'.");
         const auto opt = config_.findInclude(include);
         if (opt.has_value()) {
             fp = opt.value();
         } else {
-            logger_.debug("Symbol file not found: '" + include.string() + "'.");
+            logger_->debug("Symbol file not found: '" + include.string() + "'.");
             return nullptr;
         }
     }
-    logger_.debug("Symbol file found: '" + fp.string() + "'.");
-    const auto file = make_unique<SymbolFile>();
+    logger_->debug("Symbol file found: '" + fp.string() + "'.");
+    const auto entry = ImportCache::instance().get(config_, fp, name, *logger_);
+    if (!entry) {
+        return nullptr;
+    }
+    // the declarations of the imported module are shared with all other compilations that import it
+    context_.addImportedModule(entry);
+    if (!symbols_->getModule(name)) {
+        symbols_->addModule(name);
+        entry->declarations([this, &name](const string &ident, DeclarationNode *decl) {
+            symbols_->import(name, ident, decl);
+        });
+        symbols_->setLoader(name, [this, entry, name](const Symbol symbol) {
+            const auto ident = Interner::name(symbol);
+            if (const auto decl = entry->lookup(*logger_, ident)) {
+                symbols_->import(name, ident, decl);
+            }
+        });
+        modules_.push_back(name);
+    }
+    return entry->getModule();
+}
+
+ModuleNode *SymbolImporter::readSymbolFile(const path &fp, const string &name) {
+    auto file = make_unique<SymbolFile>();
     file->open(fp.string(), std::ios::in);
 
     // read symbol file header
@@ -40,8 +65,8 @@ ModuleNode *SymbolImporter::read(const string &name) {
     [[maybe_unused]] auto ident = file->readString();
     const auto version = file->readChar();
     if (version != SymbolFile::VERSION) {
-        logger_.error(fp.string(), "Wrong symbol file version: expected " + to_string(SymbolFile::VERSION) +
-                                   ", found " + to_string(static_cast<int>(version)) + ".");
+        logger_->error(fp.string(), "Wrong symbol file version: expected " + to_string(SymbolFile::VERSION) +
+                                    ", found " + to_string(static_cast<int>(version)) + ".");
         return nullptr;
     }
 #ifdef _DEBUG
@@ -49,6 +74,16 @@ ModuleNode *SymbolImporter::read(const string &name) {
 #endif
     // get or create module
     module_ = getOrCreateModule(name);
+    auto import = make_unique<Import>();
+    import->module = module_;
+    // read index of the declarations that are loaded on demand
+    const auto count = file->readInt();
+    for (int i = 0; i < count && !file->eof(); ++i) {
+        const auto symbol = Interner::intern(file->readString());
+        import->index[symbol] = static_cast<size_t>(file->readInt());
+    }
+    // read type declarations, which are loaded eagerly as all other declarations can refer to them
+    loading_ = true;
     auto ch = file->readChar();
     while (ch != 0 && !file->eof()) {
         const auto nodeType = static_cast<NodeType>(ch);
@@ -59,27 +94,74 @@ ModuleNode *SymbolImporter::read(const string &name) {
         // check for terminator
         ch = file->readChar();
     }
+    readForwardTypes(file.get());
+    loading_ = false;
 #ifdef _DEBUG
     std::cout << std::endl;
 #endif
+    import->xrefs = std::move(xrefs_);
+    import->named = std::move(named_);
     xrefs_.clear();
+    named_.clear();
     if (!fwds_.empty()) {
-        logger_.error(fp.string(), "Unresolved forward type references during import.");
+        logger_->error(fp.string(), "Unresolved forward type references during import.");
         fwds_.clear();
     }
-    file->flush();
-    file->close();
+    import->file = std::move(file);
+    const auto res = module_;
+    const auto state = import.get();
+    imports_[name] = std::move(import);
+    symbols_->setLoader(name, [this, state](const Symbol symbol) { load(*state, symbol); });
 #ifdef _DEBUG
     const auto printer = make_unique<NodePrettyPrinter>(std::cout);
     printer->print(module_);
 #endif
-    return module_;
+    return res;
+}
+
+void SymbolImporter::setLogger(Logger &logger) {
+    logger_ = &logger;
+}
+
+SymbolImporter::~SymbolImporter() {
+    for (const auto &[name, import] : imports_) {
+        symbols_->setLoader(name, nullptr);
+    }
+    for (const auto &name : modules_) {
+        symbols_->setLoader(name, nullptr);
+    }
+}
+
+void SymbolImporter::load(Import &import, const Symbol symbol) {
+    const auto it = import.index.find(symbol);
+    // types referenced while loading are resolved without loading further declarations
+    if (loading_ || it == import.index.end()) {
+        return;
+    }
+    const auto file = import.file.get();
+    file->seek(it->second);
+    import.index.erase(it);
+    logger_->debug("Loading declaration '" + Interner::name(symbol) + "' from symbol file: '" + file->path() + "'.");
+    // each declaration can refer to the eagerly loaded types and to the types that it contains itself
+    loading_ = true;
+    module_ = import.module;
+    xrefs_ = import.xrefs;
+    named_.swap(import.named);
+    readDeclaration(file, static_cast<NodeType>(file->readChar()));
+    readForwardTypes(file);
+    named_.swap(import.named);
+    xrefs_.clear();
+    loading_ = false;
+    if (!fwds_.empty()) {
+        logger_->error(file->path(), "Unresolved forward type references during import.");
+        fwds_.clear();
+    }
 }
 
 void SymbolImporter::readDeclaration(SymbolFile *file, const NodeType nodeType) {
     // read the symbol name
     auto name = file->readString();
-    auto ident = make_unique<IdentDef>(name);
+    auto ident = context_.make<IdentDef>(name);
     // check whether symbol already exists
     const auto module = module_->getIdentifier()->name();
     const auto decl = dynamic_cast<TypeDeclarationNode *>(symbols_->lookup(module, name));
@@ -96,37 +178,37 @@ void SymbolImporter::readDeclaration(SymbolFile *file, const NodeType nodeType)
             std::unique_ptr<ExpressionNode> expr;
             switch (kind) {
                 case TypeKind::STRING:
-                    expr = make_unique<StringLiteralNode>(EMPTY_POS, file->readString(), type);
+                    expr = context_.make<StringLiteralNode>(EMPTY_POS, file->readString(), type);
                     break;
                 case TypeKind::BOOLEAN:
-                    expr = make_unique<BooleanLiteralNode>(EMPTY_POS, file->readChar() != 0, type);
+                    expr = context_.make<BooleanLiteralNode>(EMPTY_POS, file->readChar() != 0, type);
                     break;
                 case TypeKind::CHAR:
-                    expr = make_unique<CharLiteralNode>(EMPTY_POS, static_cast<unsigned char>(file->readChar()), type);
+                    expr = context_.make<CharLiteralNode>(EMPTY_POS, static_cast<unsigned char>(file->readChar()), type);
                     break;
                 case TypeKind::SHORTINT:
-                    expr = make_unique<IntegerLiteralNode>(EMPTY_POS, file->readShort(), type);
+                    expr = context_.make<IntegerLiteralNode>(EMPTY_POS, file->readShort(), type);
                     break;
                 case TypeKind::INTEGER:
-                    expr = make_unique<IntegerLiteralNode>(EMPTY_POS, file->readInt(), type);
+                    expr = context_.make<IntegerLiteralNode>(EMPTY_POS, file->readInt(), type);
                     break;
                 case TypeKind::LONGINT:
-                    expr = make_unique<IntegerLiteralNode>(EMPTY_POS, file->readLong(), type);
+                    expr = context_.make<IntegerLiteralNode>(EMPTY_POS, file->readLong(), type);
                     break;
                 case TypeKind::REAL:
-                    expr = make_unique<RealLiteralNode>(EMPTY_POS, file->readFloat(), type);
+                    expr = context_.make<RealLiteralNode>(EMPTY_POS, file->readFloat(), type);
                     break;
                 case TypeKind::LONGREAL:
-                    expr = make_unique<RealLiteralNode>(EMPTY_POS, file->readDouble(), type);
+                    expr = context_.make<RealLiteralNode>(EMPTY_POS, file->readDouble(), type);
                     break;
                 case TypeKind::SET:
-                    expr = make_unique<SetLiteralNode>(EMPTY_POS, bitset<32>(static_cast<unsigned>(file->readInt())), type);
+                    expr = context_.make<SetLiteralNode>(EMPTY_POS, bitset<32>(static_cast<unsigned>(file->readInt())), type);
                     break;
                 default:
-                    logger_.error(file->path(), "Cannot import constant " + name + ".");
+                    logger_->error(file->path(), "Cannot import constant " + name + ".");
             }
             if (expr) {
-                auto node = make_unique<ConstantDeclarationNode>(std::move(ident), std::move(expr));
+                auto node = context_.make<ConstantDeclarationNode>(std::move(ident), std::move(expr));
                 symbols_->import(module_->getIdentifier()->name(), name, node.get());
                 node->setModule(module_);
                 module_->constants().push_back(std::move(node));
@@ -134,26 +216,34 @@ void SymbolImporter::readDeclaration(SymbolFile *file, const NodeType nodeType)
         }
     } else if (nodeType == NodeType::type && !decl) {
         // type declaration
-        auto node = make_unique<TypeDeclarationNode>(EMPTY_POS, std::move(ident), type);
+        auto node = context_.make<TypeDeclarationNode>(EMPTY_POS, std::move(ident), type);
         symbols_->import(module_->getIdentifier()->name(), name, node.get());
         node->setModule(module_);
         module_->types().push_back(std::move(node));
     } else if (nodeType == NodeType::variable) {
         // variable declaration
         [[maybe_unused]] auto exno = file->readChar();  // read in export number
-        auto node = make_unique<VariableDeclarationNode>(EMPTY_POS, std::move(ident), type);
+        type = context_.getCanonicalType(type);
+        auto node = context_.make<VariableDeclarationNode>(EMPTY_POS, std::move(ident), type);
         symbols_->import(module_->getIdentifier()->name(), name, node.get());
         node->setModule(module_);
         module_->variables().push_back(std::move(node));
     } else if (nodeType == NodeType::procedure) {
         // procedure declaration
-        auto node = make_unique<ProcedureDeclarationNode>(std::move(ident), dynamic_cast<ProcedureTypeNode *>(type));
+        auto node = context_.make<ProcedureDeclarationNode>(std::move(ident), dynamic_cast<ProcedureTypeNode *>(type));
         symbols_->import(module_->getIdentifier()->name(), name, node.get());
         node->setModule(module_);
         module_->procedures().push_back(std::move(node));
     }
 }
 
+void SymbolImporter::readForwardTypes(SymbolFile *file) {
+    // read the types that have been forward-referenced by pointer types, but not yet been written out
+    while (file->readChar() != 0 && !file->eof()) {
+        readType(file);
+    }
+}
+
 TypeNode *SymbolImporter::readType(SymbolFile *file, const TypeDeclarationNode *decl, PointerTypeNode *ptr) {
     TypeNode *type = nullptr;
     const auto ch = file->readChar();
@@ -174,7 +264,7 @@ TypeNode *SymbolImporter::readType(SymbolFile *file, const TypeDeclarationNode *
             fwds_[ref] = ptr;
             return nullptr;
         }
-        logger_.error(file->path(), "Unresolved type reference during import: " + to_string(ref) + ".");
+        logger_->error(file->path(), "Unresolved type reference during import: " + to_string(ref) + ".");
         return nullptr;
     }
     // handle re-exported types
@@ -186,6 +276,10 @@ TypeNode *SymbolImporter::readType(SymbolFile *file, const TypeDeclarationNode *
             // check whether re-exported type has already been imported
             name = file->readString();
             decl = dynamic_cast<TypeDeclarationNode *>(symbols_->lookup(module, name));
+            // resolve types re-exported from another module through that module, so that they keep their identity
+            if (!decl && module != module_->getIdentifier()->name() && !symbols_->getModule(module) && read(module)) {
+                decl = dynamic_cast<TypeDeclarationNode *>(symbols_->lookup(module, name));
+            }
         }
     }
     // read, possibly redundant, type description
@@ -203,10 +297,15 @@ TypeNode *SymbolImporter::readType(SymbolFile *file, const TypeDeclarationNode *
         // discard just imported type, if it has already been imported previously
         type = decl->getType();
     } else if (type) {
-        // import a re-exported
-        if (!module.empty()) {
+        if (module == module_->getIdentifier()->name()) {
+            // discard just imported type, if it has already been written out by a previous declaration
+            if (const auto [it, inserted] = named_.try_emplace(name, type); !inserted) {
+                type = it->second;
+            }
+        } else if (!module.empty()) {
+            // import a re-exported
             const auto external = getOrCreateModule(module);
-            auto node = make_unique<TypeDeclarationNode>(EMPTY_POS, make_unique<IdentDef>(name), type);
+            auto node = context_.make<TypeDeclarationNode>(EMPTY_POS, context_.make<IdentDef>(name), type);
             symbols_->import(module, name, node.get());
             node->setModule(external);
             external->types().push_back(std::move(node));
@@ -274,7 +373,8 @@ TypeNode *SymbolImporter::readProcedureType(SymbolFile *file) {
         } else {
             index++;
         }
-        auto param = make_unique<ParameterNode>(EMPTY_POS, make_unique<Ident>("_"), type, (var == 0), index);
+        auto param = context_.make<ParameterNode>(EMPTY_POS, context_.make<Ident>("_"),
+                                                 context_.getCanonicalType(type), (var == 0), index);
         param->setScope(SymbolTable::MODULE_SCOPE);
         params.push_back(std::move(param));
         // check for terminator
@@ -312,7 +412,7 @@ TypeNode *SymbolImporter::readRecordType(SymbolFile *file) {
         }
         // read field offset
         [[maybe_unused]] auto offset = file->readInt();
-        fields.push_back(make_unique<FieldNode>(EMPTY_POS, make_unique<IdentDef>(name), type, index));
+        fields.push_back(context_.make<FieldNode>(EMPTY_POS, context_.make<IdentDef>(name), type, static_cast<unsigned>(index)));
         // check for terminator
         ch = file->readChar();
     }
@@ -340,7 +440,7 @@ TypeNode *SymbolImporter::getXRef(unsigned ref) const {
 ModuleNode *SymbolImporter::getOrCreateModule(const std::string &module) const {
     if (!symbols_->getModule(module)) {
         symbols_->addModule(module);
-        context_.addExternalModule(make_unique<ModuleNode>(make_unique<Ident>(module)));
+        context_.addExternalModule(context_.make<ModuleNode>(context_.make<Ident>(module)));
     }
     return context_.getExternalModule(module);
 }
@@ -5,9 +5,11 @@
 #ifndef OBERON_LANG_SYMBOLIMPORTER_H
 #define OBERON_LANG_SYMBOLIMPORTER_H
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Logger.h"
@@ -19,25 +21,32 @@
 #include "data/ast/TypeNode.h"
 #include "system/OberonSystem.h"
 
+using std::filesystem::path;
 using std::map;
 using std::string;
 using std::unique_ptr;
+using std::unordered_map;
 using std::vector;
 
 class SymbolImporter {
 
 public:
     explicit SymbolImporter(CompilerConfig &config, ASTContext &context, OberonSystem &system) :
-            config_(config), context_(context), logger_(config.logger()), system_(system),
-            symbols_(system.getSymbolTable()), module_() {}
-    ~SymbolImporter() = default;
+            config_(config), context_(context), logger_(&config.logger()), system_(system),
+            symbols_(system.getSymbolTable()), module_(), loading_(false) {}
+    ~SymbolImporter();
 
+    // Imports a module through the import cache and makes its declarations known to the symbol table.
     ModuleNode *read(const string &);
+    // Reads the symbol file of a module into the context of this importer.
+    ModuleNode *readSymbolFile(const path &, const string &);
+
+    void setLogger(Logger &);
 
 private:
     CompilerConfig &config_;
     ASTContext &context_;
-    Logger &logger_;
+    Logger *logger_;
     OberonSystem &system_;
     SymbolTable *symbols_;
     ModuleNode *module_;
@@ -46,8 +55,26 @@ private:
     map<unsigned, TypeNode*> xrefs_;
     // forward declarations
     map<unsigned, PointerTypeNode *> fwds_;
+    // named types of the imported module that are not (yet) known to the symbol table
+    map<string, TypeNode *> named_;
+    bool loading_;
+
+    // State of an imported module whose declarations are loaded lazily from its symbol file.
+    struct Import {
+        unique_ptr<SymbolFile> file;
+        ModuleNode *module;
+        map<unsigned, TypeNode *> xrefs;
+        map<string, TypeNode *> named;
+        unordered_map<Symbol, size_t> index;
+    };
+    map<string, unique_ptr<Import>> imports_;
+    // modules that have been imported through the import cache
+    vector<string> modules_;
+
+    void load(Import &, Symbol);
 
     void readDeclaration(SymbolFile *, NodeType);
+    void readForwardTypes(SymbolFile *);
     TypeNode *readType(SymbolFile *, const TypeDeclarationNode * = nullptr, PointerTypeNode * = nullptr);
     TypeNode *readArrayType(SymbolFile *);
     TypeNode *readPointerType(SymbolFile *, unsigned);
@@ -6,10 +6,11 @@
 
 #include "SymbolTable.h"
 
-#include <iostream>
 #include <memory>
 #include <string>
 
+#include "global.h"
+
 using std::make_unique;
 using std::string;
 
@@ -24,20 +25,24 @@ SymbolTable::~SymbolTable() = default;
 
 void SymbolTable::import(const string &module, const string &name, DeclarationNode *node) {
     if (const auto scope = getModule(module)) {
-        node->setScope(MODULE_SCOPE);
-        scope->insert(name, node);
+        // declarations of imported modules can be shared by several symbol tables, avoid redundant writes
+        if (node->getScope() != MODULE_SCOPE) {
+            node->setScope(MODULE_SCOPE);
+        }
+        scope->insert(Interner::intern(name), node);
     } else {
-        // TODO throw exception
-        std::cerr << "Illegal symbol table state: namespace " + module + " does not exists." << std::endl;
-        exit(1);
+        throw CompilerError("illegal symbol table state: namespace " + module + " does not exist.");
     }
 }
 
 void SymbolTable::insert(const string &name, DeclarationNode *node) const {
+    insert(Interner::intern(name), node);
+}
+
+void SymbolTable::insert(const Symbol name, DeclarationNode *node) const {
 #ifdef _DEBUG
-    if (name.empty() || node == nullptr) {
-        std::cerr << "Illegal symbol table state: trying to insert anonymous or null declaration." << std::endl;
-        exit(1);
+    if (name == Interner::EMPTY || node == nullptr) {
+        throw CompilerError("illegal symbol table state: trying to insert anonymous or null declaration.");
     }
 #endif
     scope_->insert(name, node);
@@ -46,26 +51,35 @@ void SymbolTable::insert(const string &name, DeclarationNode *node) const {
 void SymbolTable::insertGlobal(const string &name, DeclarationNode *node) const {
 #ifdef _DEBUG
     if (name.empty() || node == nullptr) {
-        std::cerr << "Illegal symbol table state: trying to insert anonymous or null declaration." << std::endl;
-        exit(1);
+        throw CompilerError("illegal symbol table state: trying to insert anonymous or null declaration.");
     }
 #endif
-    universe_->insert(name, node);
+    universe_->insert(Interner::intern(name), node);
 }
 
 DeclarationNode *SymbolTable::lookup(Ident *ident) const {
     if (ident->isQualified()) {
-        return this->lookup(dynamic_cast<QualIdent*>(ident)->qualifier(), ident->name());
+        return this->lookup(dynamic_cast<QualIdent*>(ident)->qualifierSymbol(), ident->symbol());
     }
-    return this->lookup({}, ident->name());
+    return this->lookup(Interner::EMPTY, ident->symbol());
 }
 
 DeclarationNode *SymbolTable::lookup(const string &qualifier, const string &name) const {
-    if (!qualifier.empty()) {
-        if (aliases_.contains(qualifier)) {
-            const string module = aliases_.find(qualifier)->second;
-            if (const auto it = scopes_.find(module); it != scopes_.end()) {
-                return it->second->lookup(name, true);
+    return this->lookup(Interner::intern(qualifier), Interner::intern(name));
+}
+
+DeclarationNode *SymbolTable::lookup(const Symbol qualifier, const Symbol name) const {
+    if (qualifier != Interner::EMPTY) {
+        if (const auto alias = aliases_.find(qualifier); alias != aliases_.end()) {
+            if (const auto it = scopes_.find(alias->second); it != scopes_.end()) {
+                if (const auto node = it->second->lookup(name, true)) {
+                    return node;
+                }
+                // declarations of imported modules might not have been loaded yet
+                if (const auto loader = loaders_.find(alias->second); loader != loaders_.end()) {
+                    loader->second(name);
+                    return it->second->lookup(name, true);
+                }
             }
         }
         return nullptr;
@@ -79,17 +93,18 @@ DeclarationNode *SymbolTable::lookup(const string &qualifier, const string &name
 }
 
 void SymbolTable::addAlias(const string &alias, const string &module) {
-    if (aliases_.contains(module)) {
-        aliases_.erase(module);
+    const auto symbol = Interner::intern(module);
+    if (aliases_.contains(symbol)) {
+        aliases_.erase(symbol);
     }
-    aliases_[alias] = module;
+    aliases_[Interner::intern(alias)] = symbol;
 }
 
-bool SymbolTable::isDuplicate(const string &name) const {
+bool SymbolTable::isDuplicate(const Symbol name) const {
     return scope_->lookup(name, true) != nullptr;
 }
 
-bool SymbolTable::isGlobal(const string &name) const {
+bool SymbolTable::isGlobal(const Symbol name) const {
     return universe_->lookup(name, true) != nullptr;
 }
 
@@ -103,20 +118,28 @@ void SymbolTable::setNilType(TypeNode *nilType) {
 
 void SymbolTable::addModule(const string &module, const bool activate) {
     if (getModule(module)) {
-        // TODO throw exception
-        std::cerr << "Illegal symbol table state: namespace " + module + " already exists." << std::endl;
-        exit(1);
+        throw CompilerError("illegal symbol table state: namespace " + module + " already exists.");
     }
     auto scope = make_unique<Scope>(GLOBAL_SCOPE, nullptr);
     if (activate) {
         scope_ = scope.get();
     }
-    scopes_[module] = std::move(scope);
-    aliases_[module] = module;
+    const auto symbol = Interner::intern(module);
+    scopes_[symbol] = std::move(scope);
+    aliases_[symbol] = symbol;
+}
+
+void SymbolTable::setLoader(const string &module, function<void(Symbol)> loader) {
+    const auto symbol = Interner::intern(module);
+    if (loader) {
+        loaders_[symbol] = std::move(loader);
+    } else {
+        loaders_.erase(symbol);
+    }
 }
 
 Scope *SymbolTable::getModule(const string &module) {
-    if (const auto itr = scopes_.find(module); itr != scopes_.end()) {
+    if (const auto itr = scopes_.find(Interner::intern(module)); itr != scopes_.end()) {
         return itr->second.get();
     }
     return nullptr;
@@ -132,9 +155,7 @@ void SymbolTable::closeScope() {
     if (scope_->getLevel() > GLOBAL_SCOPE) {
         scope_ = scope_->getParent();
     } else {
-        // TODO throw exception
-        std::cerr << "Illegal symbol table state: cannot leave current scope." << std::endl;
-        exit(1);
+        throw CompilerError("illegal symbol table state: cannot leave current scope.");
     }
 }
 
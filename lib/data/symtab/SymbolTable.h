@@ -8,6 +8,7 @@
 #define OBERON0C_TABLE_H
 
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -19,6 +20,7 @@
 #include "data/ast/ProcedureNode.h"
 #include "data/ast/PointerTypeNode.h"
 
+using std::function;
 using std::string;
 using std::unique_ptr;
 using std::unordered_map;
@@ -37,6 +39,7 @@ public:
     void import(const string &module, const string &name, DeclarationNode *node);
 
     void insert(const string &name, DeclarationNode *node) const;
+    void insert(Symbol name, DeclarationNode *node) const;
     void insertGlobal(const string &name, DeclarationNode *node) const;
 
     [[nodiscard]] DeclarationNode *lookup(const string &qualifier, const string &name) const;
@@ -44,13 +47,16 @@ public:
 
     void addAlias(const string &alias, const string &module);
 
-    [[nodiscard]] bool isDuplicate(const string &name) const;
-    [[nodiscard]] bool isGlobal(const string &name) const;
+    [[nodiscard]] bool isDuplicate(Symbol name) const;
+    [[nodiscard]] bool isGlobal(Symbol name) const;
 
     [[nodiscard]] TypeNode *getNilType() const;
     void setNilType(TypeNode *nilType);
 
     void addModule(const string &module, bool activate = false);
+    // Sets a loader that is invoked with the name of a symbol that is looked up in, but not found in the scope of
+    // the given imported module. The loader is expected to import the declaration of that symbol, if there is one.
+    void setLoader(const string &module, function<void(Symbol)> loader);
     [[nodiscard]] Scope *getModule(const string &module);
 
     void openScope();
@@ -62,11 +68,16 @@ public:
     static const unsigned int MODULE_SCOPE;
 
 private:
-    unordered_map<string, unique_ptr<Scope>> scopes_;
-    unordered_map<string, string> aliases_;
+    unordered_map<Symbol, unique_ptr<Scope>> scopes_;
+    unordered_map<Symbol, Symbol> aliases_;
+    unordered_map<Symbol, function<void(Symbol)>> loaders_;
     Scope *scope_;
     unique_ptr<Scope> universe_;
     TypeNode *nilType_{};
+
+    // Unqualified names are looked up with the qualifier `Interner::EMPTY`.
+    [[nodiscard]] DeclarationNode *lookup(Symbol qualifier, Symbol name) const;
+
 };
 
 
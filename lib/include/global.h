@@ -8,6 +8,7 @@
 #define OBERON_LLVM_GLOBAL_H
 
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -35,6 +36,22 @@ struct SourceLoc {
 static const FilePos EMPTY_POS = {"", 0, 0, 0 };
 static const SourceLoc EMPTY_LOC = {"", {0, 0, 0}, {0, 0, 0}};
 
+// Aborts the compilation of the current module because of an error that cannot be recovered from, e.g., an input
+// file that cannot be read or an illegal internal state. The error is reported by the compiler, which continues with
+// the next module, see `Compiler`.
+class CompilerError : public std::runtime_error {
+
+public:
+    CompilerError(const FilePos &pos, const std::string &msg) : std::runtime_error(msg), pos_(pos) {};
+    explicit CompilerError(const std::string &msg) : CompilerError(EMPTY_POS, msg) {};
+
+    [[nodiscard]] const FilePos &pos() const { return pos_; };
+
+private:
+    FilePos pos_;
+
+};
+
 template <typename T>
 static std::string to_string(T obj) {
     std::stringstream stream;
@@ -3,3 +3,294 @@
 //
 
 #include "LLDWrapper.h"
+
+#include <sstream>
+
+#ifdef _LLD
+#include <lld/Common/Driver.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Program.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/VersionTuple.h>
+#include <llvm/TargetParser/Triple.h>
+
+LLD_HAS_DRIVER(elf)
+LLD_HAS_DRIVER(macho)
+LLD_HAS_DRIVER(coff)
+
+using llvm::Triple;
+#endif
+
+void LLDWrapper::addLibraryDirectory(const path &directory) {
+    libdirs_.push_back(directory);
+}
+
+void LLDWrapper::addLibrary(const string &library) {
+    libs_.push_back(library);
+}
+
+void LLDWrapper::setLTO(const unsigned level, const unsigned jobs) {
+    level_ = level;
+    jobs_ = jobs == 0 ? 1 : jobs;
+}
+
+void LLDWrapper::setProfile(const bool profile) {
+    profile_ = profile;
+}
+
+#ifdef _LLD
+// Runs the given program and returns the first line of its output.
+static optional<string> execute(const string &program, const vector<string> &args) {
+    const auto exe = llvm::sys::findProgramByName(program);
+    if (!exe) {
+        return std::nullopt;
+    }
+    llvm::SmallString<128> tmp;
+    if (llvm::sys::fs::createTemporaryFile("olang", "txt", tmp)) {
+        return std::nullopt;
+    }
+    vector<llvm::StringRef> argv = { exe.get() };
+    argv.insert(argv.end(), args.begin(), args.end());
+    const std::optional<llvm::StringRef> redirects[] = { std::nullopt, llvm::StringRef(tmp), std::nullopt };
+    const int status = llvm::sys::ExecuteAndWait(exe.get(), argv, std::nullopt, redirects);
+    auto buffer = llvm::MemoryBuffer::getFile(tmp);
+    llvm::sys::fs::remove(tmp);
+    if (status != 0 || !buffer) {
+        return std::nullopt;
+    }
+    return buffer.get()->getBuffer().split('\n').first.trim().str();
+}
+
+// Asks the C compiler of the system for the location of the given start-up file or library.
+static optional<path> locate(const string &file) {
+    const auto result = execute("cc", { "-print-file-name=" + file });
+    // The C compiler echoes the name of a file that it does not find
+    if (!result || !path(result.value()).is_absolute() || !exists(path(result.value()))) {
+        return std::nullopt;
+    }
+    return path(result.value()).lexically_normal();
+}
+
+optional<path> LLDWrapper::query(const string &file) const {
+    const auto result = locate(file);
+    if (!result) {
+        logger_.error(string(), "file required for linking not found: '" + file + "'.");
+    }
+    return result;
+}
+
+// Asks the C compiler of the system for the dynamic linker, whose name depends on the C library (glibc or musl) and
+// whose location depends on the distribution, e.g., on multiarch systems.
+optional<path> LLDWrapper::loader() const {
+    const Triple triple(triple_);
+    vector<string> names;
+    switch (triple.getArch()) {
+        case Triple::x86_64:
+            names = { "ld-linux-x86-64.so.2", "ld-musl-x86_64.so.1" };
+            break;
+        case Triple::x86:
+            names = { "ld-linux.so.2", "ld-musl-i386.so.1" };
+            break;
+        case Triple::aarch64:
+            names = { "ld-linux-aarch64.so.1", "ld-musl-aarch64.so.1" };
+            break;
+        case Triple::riscv64:
+            names = { "ld-linux-riscv64-lp64d.so.1", "ld-musl-riscv64.so.1" };
+            break;
+        default:
+            logger_.error(string(), "linking is not supported for target: '" + triple_ + "'.");
+            return std::nullopt;
+    }
+    for (const auto &name : names) {
+        if (auto file = locate(name)) {
+            return file;
+        }
+        // Some C compilers do not search the directories of the dynamic linker
+        for (const auto &dir : { "/lib", "/lib64" }) {
+            if (const auto file = path(dir) / name; exists(file)) {
+                return file;
+            }
+        }
+    }
+    logger_.error(string(), "dynamic linker required for linking not found for target: '" + triple_ + "'.");
+    return std::nullopt;
+}
+
+// Asks Clang for the location of the given library of the compiler runtime (compiler-rt).
+optional<path> LLDWrapper::runtime(const string &name) const {
+    if (const auto dir = execute("clang", { "--target=" + triple_, "-print-runtime-dir" })) {
+        const Triple triple(triple_);
+        const auto arch = triple.getArchName().str();
+        vector<path> candidates;
+        if (triple.isOSDarwin()) {
+            candidates.push_back(path(dir.value()) / ("libclang_rt." + name + "_osx.a"));
+        } else if (triple.isOSWindows() && !triple.isOSCygMing()) {
+            candidates.push_back(path(dir.value()) / ("clang_rt." + name + ".lib"));
+            candidates.push_back(path(dir.value()) / ("clang_rt." + name + "-" + arch + ".lib"));
+        } else {
+            candidates.push_back(path(dir.value()) / ("libclang_rt." + name + ".a"));
+            candidates.push_back(path(dir.value()) / ("libclang_rt." + name + "-" + arch + ".a"));
+        }
+        for (const auto &candidate : candidates) {
+            if (exists(candidate)) {
+                return candidate;
+            }
+        }
+    }
+    logger_.error(string(), "compiler runtime library required for linking not found: '" + name + "'.");
+    return std::nullopt;
+}
+
+bool LLDWrapper::gnu(vector<string> &args, const vector<path> &objects, const path &output) const {
+    const auto loader = this->loader();
+    if (!loader) {
+        return false;
+    }
+    const auto crt1 = query("crt1.o"), crti = query("crti.o"), crtn = query("crtn.o");
+    const auto crtbegin = query("crtbegin.o"), crtend = query("crtend.o");
+    const auto libc = query("libc.so");
+    if (!crt1 || !crti || !crtn || !crtbegin || !crtend || !libc) {
+        return false;
+    }
+    args = { "ld.lld", "--eh-frame-hdr", "-dynamic-linker", loader->string(), "-o", output.string(),
+             crt1->string(), crti->string(), crtbegin->string() };
+    for (const auto &dir : libdirs_) {
+        args.push_back("-L" + dir.string());
+    }
+    args.push_back("-L" + crtbegin->parent_path().string());
+    args.push_back("-L" + libc->parent_path().string());
+    if (level_) {
+        args.push_back("--lto-O" + std::to_string(level_.value()));
+        args.push_back("--thinlto-jobs=" + std::to_string(jobs_));
+    }
+    for (const auto &obj : objects) {
+        args.push_back(obj.string());
+    }
+    for (const auto &lib : libs_) {
+        args.push_back("-l" + lib);
+    }
+    if (profile_) {
+        const auto rt = runtime("profile");
+        if (!rt) {
+            return false;
+        }
+        args.insert(args.end(), { "-u__llvm_profile_runtime", rt->string() });
+    }
+    args.insert(args.end(), { "-lm", "-lc", "-lgcc", "--as-needed", "-lgcc_s", "--no-as-needed",
+                              crtend->string(), crtn->string() });
+    return true;
+}
+
+bool LLDWrapper::darwin(vector<string> &args, const vector<path> &objects, const path &output) const {
+    const Triple triple(triple_);
+    const auto sdk = execute("xcrun", { "--show-sdk-path" });
+    if (!sdk) {
+        logger_.error(string(), "macOS SDK required for linking not found.");
+        return false;
+    }
+    llvm::VersionTuple version;
+    if (!triple.getMacOSXVersion(version) || version.getMajor() < 11) {
+        version = llvm::VersionTuple(11, 0);
+    }
+    args = { "ld64.lld", "-arch", triple.isAArch64() ? "arm64" : triple.getArchName().str(),
+             "-platform_version", "macos", version.getAsString(), version.getAsString(),
+             "-syslibroot", sdk.value(), "-o", output.string() };
+    for (const auto &dir : libdirs_) {
+        args.push_back("-L" + dir.string());
+    }
+    if (level_) {
+        args.push_back("--lto-O" + std::to_string(level_.value()));
+        args.push_back("--thinlto-jobs=" + std::to_string(jobs_));
+    }
+    for (const auto &obj : objects) {
+        args.push_back(obj.string());
+    }
+    for (const auto &lib : libs_) {
+        args.push_back("-l" + lib);
+    }
+    if (profile_) {
+        const auto rt = runtime("profile");
+        if (!rt) {
+            return false;
+        }
+        args.insert(args.end(), { "-u", "___llvm_profile_runtime", rt->string() });
+    }
+    args.emplace_back("-lSystem");
+    return true;
+}
+
+bool LLDWrapper::windows(vector<string> &args, const vector<path> &objects, const path &output) const {
+    // The system libraries are found through the `LIB` environment variable of the developer command prompt
+    args = { "lld-link", "/nologo", "/subsystem:console", "/out:" + output.string(),
+             "/defaultlib:libcmt", "/defaultlib:oldnames" };
+    for (const auto &dir : libdirs_) {
+        args.push_back("/libpath:" + dir.string());
+    }
+    if (level_) {
+        args.push_back("/opt:lldlto=" + std::to_string(level_.value()));
+        args.push_back("/opt:lldltojobs=" + std::to_string(jobs_));
+    }
+    for (const auto &obj : objects) {
+        args.push_back(obj.string());
+    }
+    for (const auto &lib : libs_) {
+        args.push_back(lib + ".lib");
+    }
+    if (profile_) {
+        const auto rt = runtime("profile");
+        if (!rt) {
+            return false;
+        }
+        args.insert(args.end(), { "/include:__llvm_profile_runtime", rt->string() });
+    }
+    return true;
+}
+#endif
+
+bool LLDWrapper::link(const vector<path> &objects, const path &output) {
+#ifdef _LLD
+    const Triple triple(triple_);
+    vector<string> args;
+    bool valid;
+    if (triple.isOSDarwin()) {
+        valid = darwin(args, objects, output);
+    } else if (triple.isOSWindows() && !triple.isOSCygMing()) {
+        valid = windows(args, objects, output);
+    } else if (triple.isOSBinFormatELF()) {
+        valid = gnu(args, objects, output);
+    } else {
+        logger_.error(string(), "linking is not supported for target: '" + triple_ + "'.");
+        valid = false;
+    }
+    if (!valid) {
+        return false;
+    }
+    vector<const char *> argv;
+    std::stringstream ss;
+    for (const auto &arg : args) {
+        argv.push_back(arg.c_str());
+        ss << (argv.size() == 1 ? "" : " ") << arg;
+    }
+    logger_.debug("Linking: " + ss.str());
+    string messages;
+    llvm::raw_string_ostream err(messages);
+    const auto result = lld::lldMain(argv, llvm::outs(), err, {
+            { lld::Gnu, &lld::elf::link },
+            { lld::Darwin, &lld::macho::link },
+            { lld::WinLink, &lld::coff::link } });
+    err.flush();
+    if (result.retCode != 0) {
+        const auto message = llvm::StringRef(messages).trim().str();
+        logger_.error(output.string(), message.empty() ? "linking failed." : message);
+        return false;
+    }
+    return true;
+#else
+    (void) objects;
+    (void) output;
+    logger_.error(string(), "linking requires the LLVM linker (LLD), which was not available when building the compiler.");
+    return false;
+#endif
+}
@@ -5,18 +5,54 @@
 #ifndef OBERON_LANG_LLDWRAPPER_H
 #define OBERON_LANG_LLDWRAPPER_H
 
-#include <llvm/TargetParser/Triple.h>
 
-using llvm::Triple;
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include "Logger.h"
+
+using std::filesystem::path;
+using std::optional;
+using std::string;
+using std::vector;
+
+// Links object files and libraries to an executable using the LLVM linker (LLD) of the target platform. If the object
+// files are bitcode files with a thin-LTO summary, procedures are imported and inlined across modules at link time,
+// see `setLTO`. The start-up files and the C library are taken from the C compiler of the system.
 class LLDWrapper {
 
 private:
-    Triple triple_;
+    Logger &logger_;
+    string triple_;
+    vector<path> libdirs_;
+    vector<string> libs_;
+    optional<unsigned> level_;
+    unsigned jobs_;
+    bool profile_;
+
+    [[nodiscard]] optional<path> query(const string &) const;
+    [[nodiscard]] optional<path> runtime(const string &) const;
+    [[nodiscard]] optional<path> loader() const;
+
+    bool gnu(vector<string> &, const vector<path> &, const path &) const;
+    bool darwin(vector<string> &, const vector<path> &, const path &) const;
+    bool windows(vector<string> &, const vector<path> &, const path &) const;
 
 public:
-    explicit LLDWrapper(const Triple &triple): triple_(triple) {}
+    LLDWrapper(Logger &logger, string triple) :
+            logger_(logger), triple_(std::move(triple)), libdirs_(), libs_(), level_(), jobs_(1), profile_(false) {}
     ~LLDWrapper() = default;
+
+    void addLibraryDirectory(const path &);
+    void addLibrary(const string &);
+    // Optimizes the bitcode files at the given level using the given number of threads.
+    void setLTO(unsigned level, unsigned jobs);
+    // Links the profile runtime of the compiler runtime (compiler-rt) that writes the profile of instrumented modules.
+    void setProfile(bool);
+
+    bool link(const vector<path> &objects, const path &output);
 };
 
 
@@ -32,6 +32,12 @@ void Logger::log(LogLevel level, const string &fileName, int lineNo, int charNo,
         switch (level) {
             case LogLevel::WARNING: out << "\u001b[1m\u001b[95mwarning: \u001b[97m"; break;
             case LogLevel::ERROR:   out << "\u001b[1m\u001b[91merror: \u001b[97m";   break;
+            case LogLevel::INFO:
+                // information with a source position is a remark of an optimization
+                if (lineNo >= 0) {
+                    out << "\u001b[1m\u001b[94mremark: \u001b[97m";
+                }
+                break;
             default: break; // do nothing
         }
         out << msg << "\u001b[0m" << std::endl;
@@ -71,6 +77,10 @@ void Logger::warning(const string &fileName, const string &msg) {
     }
 }
 
+void Logger::remark(const FilePos &pos, const string &msg) {
+    log(LogLevel::INFO, pos.fileName, pos.lineNo, pos.charNo, msg);
+}
+
 void Logger::info(const string &msg) {
     log(LogLevel::INFO, msg);
 }
@@ -107,6 +117,20 @@ void Logger::setLevel(LogLevel level) {
     level_ = level;
 }
 
+LogLevel Logger::getLevel() const {
+    return level_;
+}
+
 void Logger::setWarnAsError(bool werror) {
     werror_ = werror;
 }
+
+bool Logger::isWarnAsError() const {
+    return werror_;
+}
+
+void Logger::merge(const Logger &other) {
+    for (unsigned int i = 0; i < (unsigned int) LogLevel::QUIET; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+}
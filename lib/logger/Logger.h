@@ -45,6 +45,7 @@ public:
     void error(const string &, const string &);
     void warning(const FilePos &, const string &);
     void warning(const string &, const string &);
+    void remark(const FilePos &, const string &);
     void info(const string &);
     void debug(const string &);
 
@@ -57,8 +58,13 @@ public:
     [[nodiscard]] int getErrorCount() const;
 
     void setLevel(LogLevel level);
+    [[nodiscard]] LogLevel getLevel() const;
 
     void setWarnAsError(bool werror);
+    [[nodiscard]] bool isWarnAsError() const;
+
+    // Adds the message counts of another logger to the counts of this logger.
+    void merge(const Logger &);
 
 };
 
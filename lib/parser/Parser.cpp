@@ -6,7 +6,6 @@
 
 #include "Parser.h"
 
-#include <iostream>
 #include <memory>
 #include <set>
 #include <string>
@@ -15,13 +14,13 @@
 #include "scanner/IdentToken.h"
 #include "scanner/LiteralToken.h"
 
-using std::make_unique;
 using std::unique_ptr;
 using std::vector;
 
 static OperatorType token_to_operator(TokenType token);
 
 void Parser::parse(ASTContext *context) {
+    context_ = context;
     module(context);
 }
 
@@ -32,7 +31,7 @@ unique_ptr<Ident> Parser::ident() {
         token_ = scanner_.next();
         const auto ident = dynamic_cast<const IdentToken*>(token_.get());
         logger_.debug(to_string(*ident));
-        return make_unique<Ident>(ident->start(), ident->end(), ident->value());
+        return context_->make<Ident>(ident->start(), ident->end(), ident->symbol());
     }
     // [<END>, <ELSE>, <ELSIF>, <THEN>, <UNTIL>, <BY>, <DO>, <TO>, <OF>, <MOD>, <DIV>, <OR>,
     // <<=>, <<>, <=>, <#>, <>=>, <>>, <+>, <->, <*>, <&>, <:=>, <[>, <]>, <(>, <)>, <;>, <,>, <:>, <.>]
@@ -43,7 +42,7 @@ unique_ptr<Ident> Parser::ident() {
              TokenType::op_plus, TokenType::op_minus, TokenType::op_times, TokenType::op_and, TokenType::op_becomes,
              TokenType::rbrack, TokenType::lbrack, TokenType::rparen, TokenType::lparen,
              TokenType::semicolon, TokenType::colon, TokenType::comma, TokenType::period });
-    return make_unique<Ident>(token->start(), token->end(), to_string(TokenType::undef));
+    return context_->make<Ident>(token->start(), token->end(), to_string(TokenType::undef));
 }
 
 // qualident = [ ident "." ] ident .
@@ -54,10 +53,10 @@ unique_ptr<QualIdent> Parser::qualident() {
         scanner_.next();  // skip the period
         if (assertToken(scanner_.peek(), TokenType::const_ident)) {
             const auto identifier = ident();
-            return make_unique<QualIdent>(qualifier->start(), identifier->end(), qualifier->name(), identifier->name());
+            return context_->make<QualIdent>(qualifier->start(), identifier->end(), qualifier->symbol(), identifier->symbol());
         }
     }
-    return make_unique<QualIdent>(qualifier->start(), qualifier->end(), qualifier->name());
+    return context_->make<QualIdent>(qualifier->start(), qualifier->end(), qualifier->symbol());
 }
 
 // identdef = ident [ "*" ] .
@@ -72,7 +71,7 @@ unique_ptr<IdentDef> Parser::identdef(const bool checkAlphaNum) {
         scanner_.next();  // skip the asterisk
         exp = true;
     }
-    return make_unique<IdentDef>(identifier->start(), identifier->end(), identifier->name(), exp);
+    return context_->make<IdentDef>(identifier->start(), identifier->end(), identifier->symbol(), exp);
 }
 
 // ident_list = identdef { "," identdef } .
@@ -769,9 +768,9 @@ unique_ptr<StatementNode> Parser::if_statement() {
     token_ = scanner_.next();  // skip IF keyword
     const FilePos ifStart = token_->start();
     unique_ptr<ExpressionNode> ifCond = expression();
-    auto thenStmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto thenStmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     vector<unique_ptr<ElseIfNode>> elseIfs;
-    auto elseStmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto elseStmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     token_ = scanner_.next();
     if (assertToken(token_.get(), TokenType::kw_then)) {
         statement_sequence(thenStmts.get());
@@ -799,7 +798,7 @@ unique_ptr<StatementNode> Parser::loop_statement() {
     token_ = scanner_.next();  // skip LOOP keyword
     const FilePos start = token_->start();
     sema_.onLoopStart(start);
-    auto stmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto stmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     statement_sequence(stmts.get());
     token_ = scanner_.next();
     if (token_->type() != TokenType::kw_end) {
@@ -817,7 +816,7 @@ unique_ptr<StatementNode> Parser::while_statement() {
     const FilePos start = token_->start();
     sema_.onLoopStart(start);
     auto cond = expression();
-    auto stmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto stmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     vector<unique_ptr<ElseIfNode>> elseIfs;
     token_ = scanner_.next();
     if (assertToken(token_.get(), TokenType::kw_do)) {
@@ -841,7 +840,7 @@ unique_ptr<StatementNode> Parser::repeat_statement() {
     token_ = scanner_.next();  // skip REPEAT keyword
     const FilePos start = token_->start();
     sema_.onLoopStart(start);
-    auto stmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto stmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     statement_sequence(stmts.get());
     unique_ptr<ExpressionNode> cond;
     token_ = scanner_.next();
@@ -876,7 +875,7 @@ unique_ptr<StatementNode> Parser::for_statement() {
         step = expression();
     }
     token_ = scanner_.next();
-    auto stmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto stmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     if (assertToken(token_.get(), TokenType::kw_do)) {
         statement_sequence(stmts.get());
     }
@@ -899,7 +898,7 @@ unique_ptr<StatementNode> Parser::case_statement() {
     auto expr = expression();
     sema_.onCaseOfStart(start, EMPTY_POS, expr);
     vector<unique_ptr<CaseNode>> cases;
-    auto elseStmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+    auto elseStmts = context_->make<StatementSequenceNode>(EMPTY_POS);
     if (assertToken(scanner_.peek(), TokenType::kw_of)) {
         scanner_.next();  // skip OF keyword
         if (scanner_.peek()->type() == TokenType::kw_else || scanner_.peek()->type() == TokenType::kw_end) {
@@ -919,7 +918,7 @@ unique_ptr<StatementNode> Parser::case_statement() {
                     scanner_.next();  // skip colon
                 }
                 auto label = sema_.onCaseLabel(caseStart, EMPTY_POS, expr, std::move(labels));
-                auto stmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+                auto stmts = context_->make<StatementSequenceNode>(EMPTY_POS);
                 statement_sequence(stmts.get());
                 cases.push_back(sema_.onCase(caseStart, EMPTY_POS, expr, std::move(label), std::move(stmts)));
             } while (scanner_.peek()->type() == TokenType::pipe);
@@ -940,7 +939,7 @@ void Parser::elsif_clause(vector<unique_ptr<ElseIfNode>> &elseIfs, const TokenTy
     auto elseIfCond = expression();
     token_ = scanner_.next();
     if (assertToken(token_.get(), type)) {
-        auto elseIfStmts = make_unique<StatementSequenceNode>(EMPTY_POS);
+        auto elseIfStmts = context_->make<StatementSequenceNode>(EMPTY_POS);
         statement_sequence(elseIfStmts.get());
         elseIfs.push_back(sema_.onElseIf(elseIfStart, token_->end(), std::move(elseIfCond), std::move(elseIfStmts)));
     }
@@ -1137,7 +1136,7 @@ unique_ptr<Selector> Parser::selector() {
     if (token->type() == TokenType::period) {
         token_ = scanner_.next();
         auto pos = token_->start();
-        return make_unique<RecordField>(pos, ident());
+        return context_->make<RecordField>(pos, ident());
     }
     if (token->type() == TokenType::lbrack) {
         auto pos = token->start();
@@ -1151,11 +1150,11 @@ unique_ptr<Selector> Parser::selector() {
         if (token_->type() != TokenType::rbrack) {
             logger_.error(token_->start(), "] expected, found " + to_string(token_->type()) + ".");
         }
-        return make_unique<ArrayIndex>(pos, std::move(expressions));
+        return context_->make<ArrayIndex>(pos, std::move(expressions));
     }
     if (token->type() == TokenType::caret) {
         token_ = scanner_.next();
-        return make_unique<Dereference>(token_->start());
+        return context_->make<Dereference>(token_->start());
     }
     if (token->type() == TokenType::lparen) {
         token_ = scanner_.next();  // skip left parenthesis
@@ -1168,7 +1167,7 @@ unique_ptr<Selector> Parser::selector() {
         logger_.debug("actual_parameters");
         token_ = scanner_.next();  // skip right parenthesis
         assertToken(token_.get(), TokenType::rparen);
-        return make_unique<ActualParameters>(start, std::move(params));
+        return context_->make<ActualParameters>(start, std::move(params));
     }
     logger_.error(token_->start(), "selector expected.");
     return nullptr;
@@ -1283,7 +1282,6 @@ OperatorType token_to_operator(const TokenType token) {
         case TokenType::op_or:     return OperatorType::OR;
         case TokenType::op_not:    return OperatorType::NOT;
         default:
-            std::cerr << "Parser cannot map token type to operator." << std::endl;
-            exit(1);
+            throw CompilerError("parser cannot map token type " + to_string(token) + " to operator.");
     }
 }
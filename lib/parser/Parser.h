@@ -39,7 +39,7 @@ class Parser {
 
 public:
     explicit Parser(CompilerConfig &config, Scanner &scanner, Sema &sema) :
-            config_(config), scanner_(scanner), sema_(sema), logger_(config_.logger()) {}
+            config_(config), scanner_(scanner), sema_(sema), logger_(config_.logger()), context_() {}
     ~Parser() = default;
 
     void parse(ASTContext *context);
@@ -49,6 +49,7 @@ private:
     Scanner &scanner_;
     Sema &sema_;
     Logger &logger_;
+    ASTContext *context_;
     unique_ptr<const Token> token_;
 
     unique_ptr<Ident> ident();
@@ -6,10 +6,14 @@
 
 #include "IdentToken.h"
 
-std::string IdentToken::value() const {
-    return value_;
+const std::string &IdentToken::value() const {
+    return Interner::name(symbol_);
+}
+
+Symbol IdentToken::symbol() const {
+    return symbol_;
 }
 
 void IdentToken::print(std::ostream &stream) const {
-    stream << this->type() << ": " << value_;
+    stream << this->type() << ": " << value();
 }
\ No newline at end of file
@@ -8,21 +8,23 @@
 #define OBERON_LANG_IDENTTOKEN_H
 
 
+#include "Interner.h"
 #include "Token.h"
 
 class IdentToken final : public Token {
 
 public:
-    explicit IdentToken(const FilePos &start, const FilePos &end, std::string value) :
-            Token(TokenType::const_ident, start, end), value_(std::move(value)) { };
+    explicit IdentToken(const FilePos &start, const FilePos &end, const Symbol symbol) :
+            Token(TokenType::const_ident, start, end), symbol_(symbol) { };
     ~IdentToken() override = default;
 
-    [[nodiscard]] std::string value() const;
+    [[nodiscard]] const std::string &value() const;
+    [[nodiscard]] Symbol symbol() const;
 
     void print(std::ostream &stream) const override;
 
 private:
-    std::string value_;
+    Symbol symbol_;
 
 };
 
@@ -0,0 +1,96 @@
+/*
+ * Process-wide pool of interned identifiers used by the Oberon LLVM compiler.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#include "Interner.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "global.h"
+
+using std::array;
+using std::shared_lock;
+using std::shared_mutex;
+using std::unique_lock;
+using std::unique_ptr;
+using std::unordered_map;
+
+// Names are stored in fixed-size chunks that are never moved, so that a symbol can be resolved without locking.
+static constexpr unsigned CHUNK_BITS = 12;
+static constexpr size_t CHUNK_SIZE = 1u << CHUNK_BITS;
+static constexpr size_t MAX_CHUNKS = 1024;
+
+struct InternerState {
+    shared_mutex mutex;
+    unordered_map<string_view, Symbol> index;
+    array<unique_ptr<string[]>, MAX_CHUNKS> chunks;
+    size_t size = 0;
+};
+
+static InternerState &state() {
+    static InternerState instance;
+    return instance;
+}
+
+static Symbol insert(InternerState &pool, const string_view name) {
+    const auto chunk = pool.size >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS) {
+        throw CompilerError("too many distinct identifiers.");
+    }
+    if (!pool.chunks[chunk]) {
+        pool.chunks[chunk] = std::make_unique<string[]>(CHUNK_SIZE);
+    }
+    const auto symbol = static_cast<Symbol>(pool.size++);
+    string &entry = pool.chunks[chunk][symbol & (CHUNK_SIZE - 1)];
+    entry = name;
+    pool.index.emplace(entry, symbol);
+    return symbol;
+}
+
+Symbol Interner::intern(const string_view name) {
+    auto &pool = state();
+    {
+        shared_lock lock(pool.mutex);
+        if (const auto it = pool.index.find(name); it != pool.index.end()) {
+            return it->second;
+        }
+    }
+    unique_lock lock(pool.mutex);
+    if (pool.size == 0) {
+        insert(pool, {});
+    }
+    if (const auto it = pool.index.find(name); it != pool.index.end()) {
+        return it->second;
+    }
+    return insert(pool, name);
+}
+
+const string &Interner::name(const Symbol symbol) {
+    if (symbol == EMPTY) {
+        static const string empty;
+        return empty;
+    }
+    return state().chunks[symbol >> CHUNK_BITS][symbol & (CHUNK_SIZE - 1)];
+}
+
+size_t Interner::size() {
+    auto &pool = state();
+    shared_lock lock(pool.mutex);
+    return pool.size;
+}
+
+void Interner::reset() {
+    auto &pool = state();
+    unique_lock lock(pool.mutex);
+    pool.index.clear();
+    for (auto &chunk : pool.chunks) {
+        chunk.reset();
+    }
+    pool.size = 0;
+}
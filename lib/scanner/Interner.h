@@ -0,0 +1,42 @@
+/*
+ * Process-wide pool of interned identifiers used by the Oberon LLVM compiler.
+ *
+ * Created by Michael Grossniklaus on 10/17/26.
+ */
+
+#ifndef OBERON_LANG_INTERNER_H
+#define OBERON_LANG_INTERNER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using std::string;
+using std::string_view;
+
+// Identifies an interned name. Two names are equal if and only if their symbols are equal.
+using Symbol = uint32_t;
+
+// The interner maps every distinct name to a small integer symbol that stays valid for the lifetime of the process.
+// Since symbols are shared by all compilations, names can be compared across AST contexts and threads. Interning
+// is thread-safe and resolving a symbol to its name is lock-free.
+class Interner {
+
+public:
+    // Throws a `CompilerError` if the pool is exhausted.
+    static Symbol intern(string_view);
+    [[nodiscard]] static const string &name(Symbol);
+    [[nodiscard]] static size_t size();
+    // Removes all names, which invalidates all symbols. Must only be called while no compilation is running and no
+    // AST is alive, including those of the import cache.
+    static void reset();
+
+    // The symbol of the empty name.
+    static constexpr Symbol EMPTY = 0;
+
+};
+
+
+#endif //OBERON_LANG_INTERNER_H
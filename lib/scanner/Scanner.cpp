@@ -7,11 +7,20 @@
 
 #include "Scanner.h"
 
+#include <array>
 #include <cctype>
+#include <cstdint>
+#include <fstream>
 #include <memory>
-#include <sstream>
 #include <string>
 
+#ifndef _WINAPI
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/convert.hpp>
@@ -19,51 +28,129 @@
 #include <boost/lexical_cast.hpp>
 
 #include "IdentToken.h"
+#include "Interner.h"
 #include "LiteralToken.h"
 #include "UndefinedToken.h"
 
+using std::array;
+using std::ifstream;
 using std::make_unique;
 using std::string;
-using std::stringstream;
 using std::unique_ptr;
 
-Scanner::Scanner(Logger &logger, const path &path) :
-        logger_(logger), path_(path), lineNo_(1), charNo_(0), ch_{}, eof_(false) {
-    init();
-    file_.open(path_.string(), std::ifstream::binary);
-    if (!file_.is_open()) {
-        logger_.error(string(), "cannot open file: " + path_.string() + ".");
-        exit(1);
+struct Keyword {
+    string_view name;
+    TokenType type;
+};
+
+static constexpr array<Keyword, 37> KEYWORDS = {{
+        { "DIV", TokenType::op_div }, { "MOD", TokenType::op_mod },
+        { "OR", TokenType::op_or }, { "IN", TokenType::op_in }, { "IS", TokenType::op_is },
+        { "MODULE", TokenType::kw_module }, { "IMPORT", TokenType::kw_import },
+        { "PROCEDURE", TokenType::kw_procedure }, { "EXTERNAL", TokenType::kw_external },
+        { "BEGIN", TokenType::kw_begin }, { "END", TokenType::kw_end },
+        { "RETURN", TokenType::kw_return },
+        { "LOOP", TokenType::kw_loop }, { "EXIT", TokenType::kw_exit },
+        { "WHILE", TokenType::kw_while }, { "DO", TokenType::kw_do },
+        { "REPEAT", TokenType::kw_repeat }, { "UNTIL", TokenType::kw_until },
+        { "FOR", TokenType::kw_for }, { "TO", TokenType::kw_to },
+        { "BY", TokenType::kw_by },
+        { "IF", TokenType::kw_if }, { "THEN", TokenType::kw_then },
+        { "ELSE", TokenType::kw_else }, { "ELSIF", TokenType::kw_elsif },
+        { "CASE", TokenType::kw_case }, { "WITH", TokenType::kw_with },
+        { "VAR", TokenType::kw_var }, { "CONST", TokenType::kw_const },
+        { "TYPE", TokenType::kw_type }, { "ARRAY", TokenType::kw_array },
+        { "RECORD", TokenType::kw_record }, { "OF", TokenType::kw_of },
+        { "POINTER", TokenType::kw_pointer }, { "NIL", TokenType::kw_nil },
+        { "TRUE", TokenType::boolean_literal }, { "FALSE", TokenType::boolean_literal } }};
+
+static constexpr size_t KEYWORD_MIN_LENGTH = 2;
+static constexpr size_t KEYWORD_MAX_LENGTH = 9;
+static constexpr unsigned KEYWORD_HASH_BITS = 6;
+static constexpr uint32_t KEYWORD_HASH_SEED = 0xfa2c3533;
+
+// Perfect hash of the keywords, which combines the length, the first two, and the last character of a name.
+static constexpr uint32_t keywordHash(const string_view name) {
+    const uint32_t key = static_cast<uint32_t>(static_cast<uint8_t>(name[0])) << 24 |
+                         static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 16 |
+                         static_cast<uint32_t>(static_cast<uint8_t>(name.back())) << 8 |
+                         static_cast<uint32_t>(name.size());
+    return key * KEYWORD_HASH_SEED >> (32 - KEYWORD_HASH_BITS);
+}
+
+static constexpr array<int8_t, 1u << KEYWORD_HASH_BITS> buildKeywordTable() {
+    array<int8_t, 1u << KEYWORD_HASH_BITS> table{};
+    table.fill(-1);
+    for (size_t i = 0; i < KEYWORDS.size(); ++i) {
+        const auto slot = keywordHash(KEYWORDS[i].name);
+        // Leave the table incomplete on collision, which is caught by the assertion below
+        if (table[slot] == -1) {
+            table[slot] = static_cast<int8_t>(i);
+        }
     }
+    return table;
+}
+
+static constexpr auto KEYWORD_TABLE = buildKeywordTable();
+
+static constexpr bool isPerfectKeywordTable() {
+    for (size_t i = 0; i < KEYWORDS.size(); ++i) {
+        const auto name = KEYWORDS[i].name;
+        if (name.size() < KEYWORD_MIN_LENGTH || name.size() > KEYWORD_MAX_LENGTH ||
+            KEYWORD_TABLE[keywordHash(name)] != static_cast<int8_t>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isPerfectKeywordTable(), "keyword hash is not perfect, choose a different seed.");
+
+Scanner::Scanner(Logger &logger, const path &path) :
+        logger_(logger), path_(path), lineNo_(1), charNo_(0), ch_{}, eof_(false),
+        buf_(nullptr), size_(0), pos_(0), mapped_(false) {
+    load();
     read();
 }
 
 Scanner::~Scanner() {
-    if (file_.is_open()) {
-        file_.close();
+#ifndef _WINAPI
+    if (mapped_) {
+        munmap(const_cast<char *>(buf_), size_);
     }
+#endif
 }
 
-void Scanner::init() {
-    keywords_ = { { "DIV", TokenType::op_div }, { "MOD", TokenType::op_mod },
-                  { "OR", TokenType::op_or }, { "IN", TokenType::op_in }, { "IS", TokenType::op_is },
-                  { "MODULE", TokenType::kw_module }, { "IMPORT", TokenType::kw_import },
-                  { "PROCEDURE", TokenType::kw_procedure }, { "EXTERNAL", TokenType::kw_external },
-                  { "BEGIN", TokenType::kw_begin }, { "END", TokenType::kw_end },
-                  { "RETURN", TokenType::kw_return },
-                  { "LOOP", TokenType::kw_loop }, { "EXIT", TokenType::kw_exit },
-                  { "WHILE", TokenType::kw_while }, { "DO", TokenType::kw_do },
-                  { "REPEAT", TokenType::kw_repeat }, { "UNTIL", TokenType::kw_until },
-                  { "FOR", TokenType::kw_for }, { "TO", TokenType::kw_to },
-                  { "BY", TokenType::kw_by },
-                  { "IF", TokenType::kw_if }, { "THEN", TokenType::kw_then },
-                  { "ELSE", TokenType::kw_else }, { "ELSIF", TokenType::kw_elsif },
-                  { "CASE", TokenType::kw_case }, { "WITH", TokenType::kw_with },
-                  { "VAR", TokenType::kw_var }, { "CONST", TokenType::kw_const },
-                  { "TYPE", TokenType::kw_type }, { "ARRAY", TokenType::kw_array },
-                  { "RECORD", TokenType::kw_record }, { "OF", TokenType::kw_of },
-                  { "POINTER", TokenType::kw_pointer }, { "NIL", TokenType::kw_nil },
-                  { "TRUE", TokenType::boolean_literal}, { "FALSE", TokenType::boolean_literal } };
+void Scanner::load() {
+#ifndef _WINAPI
+    if (const int fd = open(path_.c_str(), O_RDONLY); fd >= 0) {
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            const auto size = static_cast<size_t>(st.st_size);
+            if (void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); addr != MAP_FAILED) {
+                madvise(addr, size, MADV_SEQUENTIAL);
+                buf_ = static_cast<const char *>(addr);
+                size_ = size;
+                mapped_ = true;
+            }
+        }
+        close(fd);
+        if (mapped_) {
+            return;
+        }
+    }
+#endif
+    // Fall back to reading the whole file into memory
+    ifstream file(path_.string(), std::ifstream::binary);
+    if (!file.is_open()) {
+        throw CompilerError("cannot open file: " + path_.string() + ".");
+    }
+    data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (file.bad()) {
+        throw CompilerError({ path_.string(), -1, -1, 0 }, "error reading file.");
+    }
+    buf_ = data_.data();
+    size_ = data_.size();
 }
 
 const Token* Scanner::peek(const bool advance) {
@@ -89,12 +176,13 @@ unique_ptr<const Token> Scanner::next() {
 }
 
 void Scanner::seek(const FilePos &pos) {
-    file_.seekg(pos.offset - static_cast<streampos>(1));
+    pos_ = static_cast<size_t>(static_cast<std::streamoff>(pos.offset) - 1);
     queue<unique_ptr<const Token>> empty;
     std::swap(tokens_, empty);
     lineNo_ = pos.lineNo;
     charNo_ = pos.charNo - 1;
     ch_ = '\0';
+    eof_ = false;
 }
 
 unique_ptr<const Token> Scanner::scanToken() {
@@ -223,16 +311,22 @@ void Scanner::read() {
         lineNo_++;
         charNo_ = 0;
     }
-    if (file_.get(ch_)) {
-        charNo_++;
-    } else if (file_.eof()) {
-        charNo_++;
-        eof_ = true;
+    charNo_++;
+    if (pos_ < size_) {
+        ch_ = buf_[pos_++];
     } else {
-        logger_.error(path_.string(), "error reading file.");
-        exit(1);
+        eof_ = true;
     }
+}
 
+// Returns the offset of the current character in the source buffer.
+size_t Scanner::index() const {
+    return eof_ ? size_ : pos_ - 1;
+}
+
+// Returns the slice of the source buffer from the given offset up to, but excluding, the current character.
+string_view Scanner::slice(const size_t start) const {
+    return { buf_ + start, index() - start };
 }
 
 FilePos Scanner::current() {
@@ -240,7 +334,7 @@ FilePos Scanner::current() {
     pos.fileName = path_.string();
     pos.lineNo = lineNo_;
     pos.charNo = charNo_;
-    pos.offset = file_.tellg();
+    pos.offset = static_cast<std::streamoff>(pos_);
     return pos;
 }
 
@@ -260,8 +354,7 @@ void Scanner::scanComment(const FilePos &pos) {
                 break;
             }
             if (eof_) {
-                logger_.error(pos, "comment not closed.");
-                exit(1);
+                throw CompilerError(pos, "comment not closed.");
             }
             read();
         }
@@ -270,27 +363,37 @@ void Scanner::scanComment(const FilePos &pos) {
             break;
         }
         if (eof_) {
-            logger_.error(pos, "comment not closed.");
-            exit(1);
+            throw CompilerError(pos, "comment not closed.");
         }
     }
 }
 
+bool Scanner::isKeyword(const string_view name, TokenType &type) {
+    if (name.size() < KEYWORD_MIN_LENGTH || name.size() > KEYWORD_MAX_LENGTH) {
+        return false;
+    }
+    const auto idx = KEYWORD_TABLE[keywordHash(name)];
+    if (idx >= 0 && KEYWORDS[static_cast<size_t>(idx)].name == name) {
+        type = KEYWORDS[static_cast<size_t>(idx)].type;
+        return true;
+    }
+    return false;
+}
+
 unique_ptr<const Token> Scanner::scanIdent() {
     FilePos pos = current();
-    std::stringstream ss;
+    const size_t start = index();
     do {
-        ss << ch_;
         read();
     } while (!eof_ && (std::isalnum(ch_) || ch_ == '_'));
-    std::string ident = ss.str();
-    if (const auto it = keywords_.find(ident); it != keywords_.end()) {
-        if (it->second == TokenType::boolean_literal) {
-            return make_unique<BooleanLiteralToken>(pos, current(), it->first == "TRUE");
+    const string_view ident = slice(start);
+    if (TokenType type; isKeyword(ident, type)) {
+        if (type == TokenType::boolean_literal) {
+            return make_unique<BooleanLiteralToken>(pos, current(), ident == "TRUE");
         }
-        return make_unique<Token>(it->second, pos, current());
+        return make_unique<Token>(type, pos, current());
     }
-    return make_unique<IdentToken>(pos, current(), ident);
+    return make_unique<IdentToken>(pos, current(), Interner::intern(ident));
 }
 
 unique_ptr<const Token> Scanner::scanNumber() {
@@ -298,25 +401,22 @@ unique_ptr<const Token> Scanner::scanNumber() {
     bool isFloat = false;
     bool isChar = false;
     FilePos pos = current();
-    std::stringstream ss;
+    const size_t start = index();
     while (!eof_ && ((ch_ >= '0' && ch_ <= '9') || (std::toupper(ch_) >= 'A' && std::toupper(ch_) <= 'F'))) {
-        ss << ch_;
         read();
         if (ch_ == '.') {
-            auto offset = file_.tellg();
-            read();
-            if (ch_ == '.') {
-                file_.seekg(offset);
+            if (pos_ < size_ && buf_[pos_] == '.') {
+                // Range operator `..` follows the number
                 break;
             }
-            ss << '.';
+            read();
             isFloat = true;
         }
         if (isFloat && (ch_ == '+' || ch_ == '-')) {
-            ss << ch_;
             read();
         }
     }
+    auto num = string(slice(start));
     if (ch_ == 'H' || ch_ == 'X') {
         if (isFloat) {
             logger_.error(pos, "undefined number.");
@@ -332,13 +432,12 @@ unique_ptr<const Token> Scanner::scanNumber() {
         read();
     }
     boost::cnv::cstream ccnv;
-    auto num = ss.str();
     if (isFloat) {
         double value;
         try {
             boost::to_upper(num);
             if (const size_t index = num.find_last_of('D'); index != string::npos) {
-                num.replace(index, 1, "E");
+                num[index] = 'E';
             } else if (auto result = boost::convert<float>(num, ccnv(std::dec)(std::scientific))) {
                 // Check whether value was too small to represent as float and has been rounded to zero
                 if (result.value() == 0) {
@@ -415,19 +514,17 @@ unique_ptr<const Token> Scanner::scanNumber() {
 //}
 
 unique_ptr<const Token> Scanner::scanString() {
-    stringstream ss;
     auto pos = current();
     read();
+    const size_t start = index();
     while (ch_ != '"') {
-        ss << ch_;
         if (ch_ == '\\') {
             read();
-            ss << ch_;
         }
         read();
     }
+    string str = unescape(string(slice(start)));
     read();
-    string str = unescape(ss.str());
     if (str.length() <= 1) {
         unsigned char value = str.empty() ? '\0' : static_cast<unsigned char>(str[0]);
         return make_unique<CharLiteralToken>(pos, current(), value);
@@ -9,23 +9,21 @@
 
 
 #include <filesystem>
-#include <fstream>
 #include <memory>
 #include <queue>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 #include "global.h"
 #include "Logger.h"
 #include "Token.h"
 
 using std::filesystem::path;
-using std::ifstream;
 using std::queue;
 using std::streampos;
 using std::string;
+using std::string_view;
 using std::unique_ptr;
-using std::unordered_map;
 
 class Scanner {
 
@@ -46,11 +44,16 @@ private:
     int lineNo_, charNo_;
     char ch_;
     bool eof_;
-    unordered_map<string, TokenType> keywords_;
-    ifstream file_;
+    // The source file is memory-mapped, if possible, or read into `data_` otherwise.
+    const char *buf_;
+    size_t size_, pos_;
+    string data_;
+    bool mapped_;
 
-    void init();
+    void load();
     void read();
+    [[nodiscard]] size_t index() const;
+    [[nodiscard]] string_view slice(size_t) const;
     FilePos current();
     unique_ptr<const Token> scanToken();
     unique_ptr<const Token> scanIdent();
@@ -59,6 +62,8 @@ private:
     unique_ptr<const Token> scanString();
     void scanComment(const FilePos &);
 
+    static bool isKeyword(string_view, TokenType &);
+
 };
 
 
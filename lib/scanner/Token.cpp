@@ -6,6 +6,57 @@
 
 #include "Token.h"
 
+#include <array>
+#include <new>
+
+static constexpr std::size_t TOKEN_SIZE_CLASS = 16;
+static constexpr std::size_t TOKEN_SIZE_CLASSES = 8;
+
+struct TokenFreeList {
+    std::array<void *, TOKEN_SIZE_CLASSES> heads{};
+
+    ~TokenFreeList() {
+        for (auto head : heads) {
+            while (head) {
+                const auto next = *static_cast<void **>(head);
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+};
+
+static thread_local TokenFreeList tokens_;
+
+static std::size_t sizeClass(const std::size_t size) {
+    return (size + TOKEN_SIZE_CLASS - 1) / TOKEN_SIZE_CLASS;
+}
+
+void *Token::operator new(const std::size_t size) {
+    const auto cls = sizeClass(size);
+    if (cls >= TOKEN_SIZE_CLASSES) {
+        return ::operator new(size);
+    }
+    if (const auto head = tokens_.heads[cls]) {
+        tokens_.heads[cls] = *static_cast<void **>(head);
+        return head;
+    }
+    return ::operator new(cls * TOKEN_SIZE_CLASS);
+}
+
+void Token::operator delete(void *ptr, const std::size_t size) {
+    if (!ptr) {
+        return;
+    }
+    const auto cls = sizeClass(size);
+    if (cls >= TOKEN_SIZE_CLASSES) {
+        ::operator delete(ptr);
+        return;
+    }
+    *static_cast<void **>(ptr) = tokens_.heads[cls];
+    tokens_.heads[cls] = ptr;
+}
+
 Token::~Token() = default;
 
 TokenType Token::type() const {
@@ -9,6 +9,7 @@
 
 
 #include "global.h"
+#include <cstddef>
 #include <ostream>
 
 enum class TokenType : char {
@@ -41,6 +42,10 @@ public:
             type_(type), start_(start), end_(end) { };
     virtual ~Token();
 
+    // Tokens are short-lived and allocated in large numbers, hence they are recycled through per-thread free lists.
+    static void *operator new(std::size_t);
+    static void operator delete(void *, std::size_t);
+
     [[nodiscard]] TokenType type() const;
     [[nodiscard]] FilePos start() const;
     [[nodiscard]] FilePos end() const;
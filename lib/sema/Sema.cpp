@@ -12,7 +12,6 @@
 #include <unordered_set>
 
 using std::bitset;
-using std::make_unique;
 using std::unique_ptr;
 using std::unordered_set;
 using std::set;
@@ -90,7 +89,7 @@ void Sema::onDeclarations() {
 
 unique_ptr<ModuleNode>
 Sema::onModuleStart(const FilePos &start, unique_ptr<Ident> ident) {
-    auto module = make_unique<ModuleNode>(start, std::move(ident));
+    auto module = context_->make<ModuleNode>(start, std::move(ident));
     // assertUnique(module->getIdentifier(), module.get());
     module->setScope(symbols_->getLevel());
     onBlockStart();
@@ -110,7 +109,7 @@ Sema::onModuleEnd(const FilePos &, const unique_ptr<Ident>& ident) const {
 unique_ptr<ImportNode>
 Sema::onImport(const FilePos &start, const FilePos &,
                unique_ptr<Ident> alias, unique_ptr<Ident> ident) {
-    auto node = make_unique<ImportNode>(start, std::move(alias), std::move(ident));
+    auto node = context_->make<ImportNode>(start, std::move(alias), std::move(ident));
     auto name = node->getModule()->name();
     // Check for duplicate imports
     for (const auto &import : context_->getTranslationUnit()->imports()) {
@@ -121,7 +120,7 @@ Sema::onImport(const FilePos &start, const FilePos &,
     }
     if (name == "SYSTEM") {
         // Import the pseudo-module SYSTEM
-        context_->addExternalModule(std::make_unique<ModuleNode>(std::make_unique<Ident>(name)));
+        context_->addExternalModule(context_->make<ModuleNode>(context_->make<Ident>(name)));
     } else if (name == context_->getTranslationUnit()->getIdentifier()->name()) {
         // Check for recursive import
         logger_.error(node->pos(), "module " + name + " must not import itself.");
@@ -151,7 +150,7 @@ Sema::onConstant(const FilePos &start, const FilePos &,
     } else {
         logger_.error(start, "undefined constant.");
     }
-    auto node = make_unique<ConstantDeclarationNode>(start, std::move(ident), std::move(expr), expr ? expr->getType() : noTy_);
+    auto node = context_->make<ConstantDeclarationNode>(start, std::move(ident), std::move(expr), expr ? expr->getType() : noTy_);
     assertUnique(node->getIdentifier(), node.get());
     node->setScope(symbols_->getLevel());
     node->setModule(context_->getTranslationUnit());
@@ -162,7 +161,7 @@ Sema::onConstant(const FilePos &start, const FilePos &,
 unique_ptr<TypeDeclarationNode>
 Sema::onType(const FilePos &start, const FilePos &,
              unique_ptr<IdentDef> ident, TypeNode *type) {
-    auto node = make_unique<TypeDeclarationNode>(start, std::move(ident), type ? type : noTy_);
+    auto node = context_->make<TypeDeclarationNode>(start, std::move(ident), type ? type : noTy_);
     assertUnique(node->getIdentifier(), node.get());
     node->setScope(symbols_->getLevel());
     node->setModule(context_->getTranslationUnit());
@@ -271,7 +270,8 @@ Sema::onParameter(const FilePos &start, const FilePos &,
         logger_.error(start, "undefined parameter type.");
         type = noTy_;
     }
-    auto node = make_unique<ParameterNode>(start, std::move(ident), type, is_var, index);
+    type = context_->getCanonicalType(type);
+    auto node = context_->make<ParameterNode>(start, std::move(ident), type, is_var, index);
     assertUnique(node->getIdentifier(), node.get());
     node->setScope(symbols_->getLevel());
     return node;
@@ -319,7 +319,8 @@ Sema::onField(const FilePos &start, const FilePos &,
         logger_.error(start, "undefined record field type.");
         type = noTy_;
     }
-    return make_unique<FieldNode>(start, std::move(ident), type, index);
+    type = context_->getCanonicalType(type);
+    return context_->make<FieldNode>(start, std::move(ident), type, index);
 }
 
 TypeNode *
@@ -361,7 +362,8 @@ Sema::onVariable(const FilePos &start, const FilePos &,
         logger_.error(start, "undefined variable type.");
         type = noTy_;
     }
-    auto node = make_unique<VariableDeclarationNode>(start, std::move(ident), type, index);
+    type = context_->getCanonicalType(type);
+    auto node = context_->make<VariableDeclarationNode>(start, std::move(ident), type, static_cast<unsigned>(index));
     assertUnique(node->getIdentifier(), node.get());
     node->setScope(symbols_->getLevel());
     node->setModule(context_->getTranslationUnit());
@@ -387,7 +389,7 @@ Sema::onProcedureDeclaration(const FilePos &start, const FilePos &, unique_ptr<I
     if (ident->isExported()) {
         logger_.error(start, "cannot export external procedures.");
     }
-    auto proc = make_unique<ProcedureDeclarationNode>(start, std::move(ident), type, convention, name);
+    auto proc = context_->make<ProcedureDeclarationNode>(start, std::move(ident), type, convention, name);
     assertUnique(proc->getIdentifier(), proc.get());
     proc->setScope(symbols_->getLevel());
     proc->setModule(context_->getTranslationUnit());
@@ -400,7 +402,7 @@ Sema::onProcedureDeclaration(const FilePos &start, const FilePos &, unique_ptr<I
 
 ProcedureDefinitionNode *
 Sema::onProcedureDefinitionStart(const FilePos &start, unique_ptr<IdentDef> ident) {
-    procs_.push(make_unique<ProcedureDefinitionNode>(start, std::move(ident)));
+    procs_.push(context_->make<ProcedureDefinitionNode>(start, std::move(ident)));
     const auto& proc = procs_.top();
     assertUnique(proc->getIdentifier(), proc.get());
     proc->setScope(symbols_->getLevel());
@@ -456,7 +458,7 @@ Sema::onAssignment(const FilePos &start, const FilePos &,
             logger_.error(rvalue->pos(), err);
         }
     }
-    return make_unique<AssignmentNode>(start, std::move(lvalue), std::move(rvalue));
+    return context_->make<AssignmentNode>(start, std::move(lvalue), std::move(rvalue));
 }
 
 unique_ptr<IfThenElseNode>
@@ -473,7 +475,7 @@ Sema::onIf(const FilePos &start, const FilePos &,
     if (type && type->kind() != TypeKind::BOOLEAN) {
         logger_.error(condition->pos(), "Boolean expression expected.");
     }
-    return make_unique<IfThenElseNode>(start, std::move(condition), std::move(thenStmts),
+    return context_->make<IfThenElseNode>(start, std::move(condition), std::move(thenStmts),
                                        std::move(elseIfs), std::move(elseStmts));
 }
 
@@ -488,7 +490,7 @@ Sema::onElseIf(const FilePos &start, const FilePos &,
     if (type && type->kind() != TypeKind::BOOLEAN) {
         logger_.error(condition->pos(), "Boolean expression expected.");
     }
-    return make_unique<ElseIfNode>(start, std::move(condition), std::move(stmts));
+    return context_->make<ElseIfNode>(start, std::move(condition), std::move(stmts));
 }
 
 void Sema::onLoopStart(const FilePos &start) {
@@ -501,7 +503,7 @@ Sema::onLoop(const FilePos &start, const FilePos &, unique_ptr<StatementSequence
         logger_.warning(start, "LOOP statement without EXIT found.");
     }
     loops_.pop();
-    return make_unique<LoopNode>(start, std::move(stmts));
+    return context_->make<LoopNode>(start, std::move(stmts));
 }
 
 unique_ptr<WhileLoopNode>
@@ -516,7 +518,7 @@ Sema::onWhileLoop(const FilePos &start, const FilePos &,
         logger_.error(condition->pos(), "Boolean expression expected.");
     }
     loops_.pop();
-    return make_unique<WhileLoopNode>(start, std::move(condition), std::move(stmts), std::move(elseIfs));
+    return context_->make<WhileLoopNode>(start, std::move(condition), std::move(stmts), std::move(elseIfs));
 }
 
 unique_ptr<RepeatLoopNode>
@@ -530,7 +532,7 @@ Sema::onRepeatLoop(const FilePos &start, const FilePos &,
         logger_.error(condition->pos(), "Boolean expression expected.");
     }
     loops_.pop();
-    return make_unique<RepeatLoopNode>(start, std::move(condition), std::move(stmts));
+    return context_->make<RepeatLoopNode>(start, std::move(condition), std::move(stmts));
 }
 
 unique_ptr<ForLoopNode>
@@ -593,7 +595,7 @@ Sema::onForLoop(const FilePos &start, const FilePos &,
         step = onIntegerLiteral(EMPTY_POS, EMPTY_POS, 1, TypeKind::INTEGER);
     }
     loops_.pop();
-    return make_unique<ForLoopNode>(start, std::move(counter), std::move(low), std::move(high), std::move(step),
+    return context_->make<ForLoopNode>(start, std::move(counter), std::move(low), std::move(high), std::move(step),
                                     std::move(stmts));
 }
 
@@ -673,7 +675,7 @@ Sema::onCaseOfEnd(const FilePos &start, const FilePos &,
     } else {
         logger_.error(expr->pos(), "type mismatch: case expression type must be integer, character, pointer, or record.");
     }
-    return make_unique<CaseOfNode>(start, std::move(expr), std::move(cases), std::move(elseStmts));
+    return context_->make<CaseOfNode>(start, std::move(expr), std::move(cases), std::move(elseStmts));
 }
 
 unique_ptr<CaseLabelNode>
@@ -763,7 +765,7 @@ Sema::onCaseLabel(const FilePos &start, const FilePos &,
             logger_.error(label->pos(), "constant expression, record type, or pointer type expected.");
         }
     }
-    return make_unique<CaseLabelNode>(start, std::move(labels), std::move(cases));
+    return context_->make<CaseLabelNode>(start, std::move(labels), std::move(cases));
 }
 
 unique_ptr<CaseNode>
@@ -782,7 +784,7 @@ Sema::onCase(const FilePos &start, const FilePos &,
             qExpr->dereference()->setType(eType);
         }
     }
-    return make_unique<CaseNode>(start, std::move(label), std::move(stmts));
+    return context_->make<CaseNode>(start, std::move(label), std::move(stmts));
 }
 
 unique_ptr<ReturnNode>
@@ -806,14 +808,14 @@ Sema::onReturn(const FilePos &start, const FilePos &, unique_ptr<ExpressionNode>
             }
         }
     }
-    return make_unique<ReturnNode>(start, std::move(expr));
+    return context_->make<ReturnNode>(start, std::move(expr));
 }
 
 unique_ptr<ExitNode> Sema::onExit(const FilePos &start, const FilePos &) const {
     if (loops_.empty()) {
         logger_.error(start, "EXIT statement outside of loop.");
     }
-    return make_unique<ExitNode>(start);
+    return context_->make<ExitNode>(start);
 }
 
 unique_ptr<StatementNode>
@@ -841,15 +843,15 @@ Sema::onQualifiedStatement(const FilePos &start, const FilePos &,
             logger_.error(ident->start(), "fewer actual than formal parameters.");
         }
         // For uniformity, add an empty parameter list to the procedure call if none is present
-        selectors.insert(selectors.end(), make_unique<ActualParameters>(ident->end()));
-        return make_unique<QualifiedStatement>(start, std::move(ident), std::move(selectors), sym);
+        selectors.insert(selectors.end(), context_->make<ActualParameters>(ident->end()));
+        return context_->make<QualifiedStatement>(start, std::move(ident), std::move(selectors), sym);
     }
     if (!selectors.empty() && selectors.back()->getNodeType() == NodeType::parameter) {
         // Looks like a proper or function procedure call
         if (type != noTy_) {
             logger_.warning(ident->start(), "discarded expression value.");
         }
-        return make_unique<QualifiedStatement>(start, std::move(ident), std::move(selectors), sym);
+        return context_->make<QualifiedStatement>(start, std::move(ident), std::move(selectors), sym);
     }
     logger_.error(ident->start(), "procedure call expected.");
     return nullptr;
@@ -861,19 +863,19 @@ Sema::onQualifiedExpression(const FilePos &start, const FilePos &,
     DeclarationNode* sym = symbols_->lookup(ident.get());
     if (!sym) {
         logger_.error(ident->start(), "undefined identifier: " + to_string(*ident) + ".");
-        return make_unique<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, noTy_);
+        return context_->make<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, noTy_);
     }
     // Check whether the qualified identifier is a variable or parameter
     if (sym->getNodeType() == NodeType::variable || sym->getNodeType() == NodeType::parameter) {
         auto type = onSelectors(ident->start(), ident->end(), sym, sym->getType(), selectors);
-        return make_unique<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, type);
+        return context_->make<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, type);
     }
     // Check whether the qualified identifier is a type identifier
     if (sym->getNodeType() == NodeType::type) {
         if (!selectors.empty()) {
             logger_.error(selectors[0]->pos(), "unexpected selector.");
         }
-        return make_unique<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, typeTy_);
+        return context_->make<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, typeTy_);
     }
     // Check whether the qualified identifier is an external or imported procedure
     if (const auto proc = dynamic_cast<ProcedureNode *>(sym)) {
@@ -887,15 +889,15 @@ Sema::onQualifiedExpression(const FilePos &start, const FilePos &,
             if (proc->isPredefined()) {
                 logger_.error(start, "predefined procedures cannot be referenced.");
             }
-            return make_unique<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, type);
+            return context_->make<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, type);
         }
         if (!selectors.empty() && selectors.back()->getNodeType() == NodeType::parameter) {
             // Looks like a call to a function procedure
-            return make_unique<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, type);
+            return context_->make<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, type);
         }
     }
     logger_.error(ident->start(), "variable, parameter, type, or function call expected.");
-    return make_unique<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, noTy_);
+    return context_->make<QualifiedExpression>(start, std::move(ident), std::move(selectors), sym, noTy_);
 }
 
 unique_ptr<ExpressionNode>
@@ -939,7 +941,7 @@ Sema::onSelectors(const FilePos &start, const FilePos &end,
         // Check for implicit pointer de-referencing
         if (base->isPointer() && (sel->getNodeType() == NodeType::array_type ||
                                   sel->getNodeType() == NodeType::record_type)) {
-            auto caret = make_unique<Dereference>(sel->pos());
+            auto caret = context_->make<Dereference>(sel->pos());
             // Place caret before the current element
             it = selectors.insert(it, std::move(caret));
             sel = it->get();
@@ -952,7 +954,7 @@ Sema::onSelectors(const FilePos &start, const FilePos &end,
                 if (param->getNodeType() == NodeType::qualified_expression &&
                     param->getType()->kind() == TypeKind::TYPE) {
                     const auto expr = dynamic_cast<QualifiedExpression *>(param);
-                    *it = make_unique<Typeguard>(params->pos(), make_unique<QualIdent>(expr->ident()));
+                    *it = context_->make<Typeguard>(params->pos(), context_->make<QualIdent>(expr->ident()));
                     sel = it->get();
                 } else {
                     logger_.error(params->pos(), "unexpected selector: illegal type guard.");
@@ -1033,10 +1035,10 @@ Sema::handleMissingParameters(const FilePos &start, const FilePos &end,
     if (base && base->isProcedure()) {
         bool found = false;
         if (selectors.empty()) {
-            it = selectors.insert(selectors.begin(), make_unique<ActualParameters>(end));
+            it = selectors.insert(selectors.begin(), context_->make<ActualParameters>(end));
             found = true;
         } else if (it + 1 != selectors.end() && (*(it +1))->getNodeType() != NodeType::parameter) {
-            it = selectors.insert(it, make_unique<ActualParameters>(end));
+            it = selectors.insert(it, context_->make<ActualParameters>(end));
             found = true;
         }
         const auto proc = dynamic_cast<ProcedureTypeNode *>(base);
@@ -1070,7 +1072,7 @@ void Sema::handleRepeatedIndices(const FilePos &, const FilePos &, Selectors &se
                 // Erase the repeated array indices
                 auto pos = selectors.erase(first, last);
                 // Place the new combined array index before the current position
-                it = selectors.insert(pos, make_unique<ArrayIndex>(EMPTY_POS, std::move(indices)));
+                it = selectors.insert(pos, context_->make<ArrayIndex>(EMPTY_POS, std::move(indices)));
             }
         }
         ++it;
@@ -1243,7 +1245,7 @@ Sema::onUnaryExpression(const FilePos &start, const FilePos &end,
     if (auto opt = fold(start, end, op, expr)) {
         return std::move(opt.value());
     }
-    return make_unique<UnaryExpressionNode>(start, op, std::move(expr), type);
+    return context_->make<UnaryExpressionNode>(start, op, std::move(expr), type);
 }
 
 unique_ptr<ExpressionNode>
@@ -1466,7 +1468,7 @@ Sema::onBinaryExpression(const FilePos &start, const FilePos &end,
         // Casting right-hand side to common type
         cast(rhs, common);
     }
-    return make_unique<BinaryExpressionNode>(start, op, std::move(lhs), std::move(rhs), result);
+    return context_->make<BinaryExpressionNode>(start, op, std::move(lhs), std::move(rhs), result);
 }
 
 unique_ptr<ExpressionNode>
@@ -1498,7 +1500,7 @@ Sema::onRangeExpression(const FilePos &start, const FilePos &,
         cast(lower, upType);
         common = upType;
     }
-    return make_unique<RangeExpressionNode>(start, std::move(lower), std::move(upper), common);
+    return context_->make<RangeExpressionNode>(start, std::move(lower), std::move(upper), common);
 }
 
 unique_ptr<ExpressionNode>
@@ -1537,7 +1539,7 @@ Sema::onSetExpression(const FilePos &start, const FilePos &,
                 auto loType = lower->getType();
                 auto upType = upper->getType();
                 auto common = loType->getSize() > upType->getSize() ? loType : upType;
-                elem = make_unique<RangeLiteralNode>(start, result, loValue, upValue, common);
+                elem = context_->make<RangeLiteralNode>(start, result, loValue, upValue, common);
             }
         } else {
             if (elem->isLiteral()) {
@@ -1549,7 +1551,7 @@ Sema::onSetExpression(const FilePos &start, const FilePos &,
             }
         }
     }
-    auto expr = make_unique<SetExpressionNode>(start, std::move(elements), setTy_);
+    auto expr = context_->make<SetExpressionNode>(start, std::move(elements), setTy_);
     if (expr->isConstant()) {
         bitset<32> result;
         for (auto &elem : expr->elements()) {
@@ -1562,7 +1564,7 @@ Sema::onSetExpression(const FilePos &start, const FilePos &,
                 }
             }
         }
-        return make_unique<SetLiteralNode>(start, result, setTy_);
+        return context_->make<SetLiteralNode>(start, result, setTy_);
     }
     return expr;
 }
@@ -1580,7 +1582,7 @@ Sema::assertInBounds(const IntegerLiteralNode *literal, const int64_t lower, con
 
 unique_ptr<BooleanLiteralNode>
 Sema::onBooleanLiteral(const FilePos &start, const FilePos &, bool value) {
-    return make_unique<BooleanLiteralNode>(start, value, boolTy_);
+    return context_->make<BooleanLiteralNode>(start, value, boolTy_);
 }
 
 unique_ptr<IntegerLiteralNode>
@@ -1593,7 +1595,7 @@ Sema::onIntegerLiteral(const FilePos &start, const FilePos &, int64_t value, con
         default:
             type = noTy_;
     }
-    return make_unique<IntegerLiteralNode>(start, value, type);
+    return context_->make<IntegerLiteralNode>(start, value, type);
 }
 
 unique_ptr<RealLiteralNode>
@@ -1605,27 +1607,27 @@ Sema::onRealLiteral(const FilePos &start, const FilePos &, double value, const T
         default:
             type = noTy_;
     }
-    return make_unique<RealLiteralNode>(start, value, type);
+    return context_->make<RealLiteralNode>(start, value, type);
 }
 
 unique_ptr<StringLiteralNode>
 Sema::onStringLiteral(const FilePos &start, const FilePos &, const string &value) {
-    return make_unique<StringLiteralNode>(start, value, stringTy_);
+    return context_->make<StringLiteralNode>(start, value, stringTy_);
 }
 
 unique_ptr<CharLiteralNode>
 Sema::onCharLiteral(const FilePos &start, const FilePos &, uint8_t value) {
-    return make_unique<CharLiteralNode>(start, value, charTy_);
+    return context_->make<CharLiteralNode>(start, value, charTy_);
 }
 
 unique_ptr<NilLiteralNode>
 Sema::onNilLiteral(const FilePos &start, const FilePos &) const {
-    return make_unique<NilLiteralNode>(start, symbols_->getNilType());
+    return context_->make<NilLiteralNode>(start, symbols_->getNilType());
 }
 
 unique_ptr<SetLiteralNode>
 Sema::onSetLiteral(const FilePos &start, const FilePos &, bitset<32> value) {
-    return make_unique<SetLiteralNode>(start, value, setTy_);
+    return context_->make<SetLiteralNode>(start, value, setTy_);
 }
 
 bool Sema::isDefined(Ident *ident) const {
@@ -1671,7 +1673,7 @@ optional<unique_ptr<LiteralNode<T>>>
 Sema::clone(const FilePos &start, const FilePos &, LiteralNode<T> *literal) {
     if (literal) {
         T value = literal->value();
-        return make_unique<L>(start, value, literal->getType(), literal->getCast());
+        return context_->make<L>(start, value, literal->getType(), literal->getCast());
     }
     return std::nullopt;
 }
@@ -1775,7 +1777,7 @@ Sema::fold(const FilePos &start, const FilePos &, const OperatorType op, const u
         if (const auto opt = boolean_cast(expr.get())) {
             switch (op) {
                 case OperatorType::NOT:
-                    return make_unique<BooleanLiteralNode>(start, !opt.value(), type, cast);
+                    return context_->make<BooleanLiteralNode>(start, !opt.value(), type, cast);
                 default:
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied to boolean values.");
             }
@@ -1784,11 +1786,11 @@ Sema::fold(const FilePos &start, const FilePos &, const OperatorType op, const u
         if (auto opt = integer_cast(expr.get())) {
             switch (op) {
                 case OperatorType::PLUS:
-                    return make_unique<IntegerLiteralNode>(start, opt.value(), type, cast);
+                    return context_->make<IntegerLiteralNode>(start, opt.value(), type, cast);
                 case OperatorType::NEG: {
                     // Negating an integer literal can change its type from LONGINT to INTEGER or INTEGER to SHORTINT
                     int64_t value = -opt.value();
-                    return make_unique<IntegerLiteralNode>(start, value, intType(value), cast);
+                    return context_->make<IntegerLiteralNode>(start, value, intType(value), cast);
                 }
                 default:
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied to integer values.");
@@ -1798,9 +1800,9 @@ Sema::fold(const FilePos &start, const FilePos &, const OperatorType op, const u
         if (auto opt = real_cast(expr.get())) {
             switch (op) {
                 case OperatorType::PLUS:
-                    return make_unique<RealLiteralNode>(start, opt.value(), type, cast);
+                    return context_->make<RealLiteralNode>(start, opt.value(), type, cast);
                 case OperatorType::NEG:
-                    return make_unique<RealLiteralNode>(start, -opt.value(), type, cast);
+                    return context_->make<RealLiteralNode>(start, -opt.value(), type, cast);
                 default:
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied to real values.");
             }
@@ -1809,7 +1811,7 @@ Sema::fold(const FilePos &start, const FilePos &, const OperatorType op, const u
         if (auto opt = set_cast(expr.get())) {
             switch (op) {
                 case OperatorType::NEG:
-                    return make_unique<SetLiteralNode>(start, opt.value().flip(), type, cast);
+                    return context_->make<SetLiteralNode>(start, opt.value().flip(), type, cast);
                 default:
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied to set values.");
             }
@@ -1827,14 +1829,14 @@ Sema::foldBinaryOp(const FilePos &start, const FilePos &,
     optional<T> rvalue = literal_cast<T>(*rhs);
     if (lvalue && rvalue) {
         T result = op(lvalue.value(), rvalue.value());
-        return make_unique<L>(start, result, common->isInteger() ? intType(static_cast<int64_t>(result)) : common);
+        return context_->make<L>(start, result, common->isInteger() ? intType(static_cast<int64_t>(result)) : common);
     }
     if (lvalue) {
         if (neutral && neutral.value() == lvalue.value()) {
             return optional(std::move(rhs));
         }
         if (zero && zero.value() == lvalue.value()) {
-            return make_unique<L>(start, 0, common->isInteger() ? shortIntTy_ : common);
+            return context_->make<L>(start, 0, common->isInteger() ? shortIntTy_ : common);
         }
     }
     if (rvalue) {
@@ -1842,7 +1844,7 @@ Sema::foldBinaryOp(const FilePos &start, const FilePos &,
             return optional(std::move(lhs));
         }
         if (zero && zero.value() == rvalue.value()) {
-            return make_unique<L>(start, 0, common->isInteger() ? shortIntTy_ : common);
+            return context_->make<L>(start, 0, common->isInteger() ? shortIntTy_ : common);
         }
     }
     return std::nullopt;
@@ -1878,17 +1880,17 @@ Sema::foldRelationOp(const FilePos &start, const FilePos &,
         T rvalue = ropt.value();
         switch (op) {
             case OperatorType::EQ:
-                return make_unique<BooleanLiteralNode>(start, lvalue == rvalue, common);
+                return context_->make<BooleanLiteralNode>(start, lvalue == rvalue, common);
             case OperatorType::NEQ:
-                return make_unique<BooleanLiteralNode>(start, lvalue != rvalue, common);
+                return context_->make<BooleanLiteralNode>(start, lvalue != rvalue, common);
             case OperatorType::LT:
-                return make_unique<BooleanLiteralNode>(start, lvalue <= rvalue, common);
+                return context_->make<BooleanLiteralNode>(start, lvalue <= rvalue, common);
             case OperatorType::LEQ:
-                return make_unique<BooleanLiteralNode>(start, lvalue < rvalue, common);
+                return context_->make<BooleanLiteralNode>(start, lvalue < rvalue, common);
             case OperatorType::GT:
-                return make_unique<BooleanLiteralNode>(start, lvalue > rvalue, common);
+                return context_->make<BooleanLiteralNode>(start, lvalue > rvalue, common);
             case OperatorType::GEQ:
-                return make_unique<BooleanLiteralNode>(start, lvalue >= rvalue, common);
+                return context_->make<BooleanLiteralNode>(start, lvalue >= rvalue, common);
             default:
                 logger_.error(start, "operator " + to_string(op) + " does not return a boolean value.");
         }
@@ -1914,14 +1916,14 @@ Sema::foldDivModOp(const FilePos &start, const FilePos &,
         }
         if (rvalue == 1) {
             if (lopt) {
-                return make_unique<IntegerLiteralNode>(start, lopt.value(), common);
+                return context_->make<IntegerLiteralNode>(start, lopt.value(), common);
             }
             return std::move(lhs);
         }
         if (lopt) {
             auto lvalue = lopt.value();
             auto result = op == OperatorType::DIV ? floor_div(lvalue, rvalue) : euclidean_mod(lvalue, rvalue);
-            return make_unique<IntegerLiteralNode>(start, result, common);
+            return context_->make<IntegerLiteralNode>(start, result, common);
         }
     }
     return std::nullopt;
@@ -1941,13 +1943,13 @@ Sema::foldFDivOp(const FilePos &start, const FilePos &,
         }
         if (rvalue == 1) {
             if (lopt) {
-                return make_unique<RealLiteralNode>(start, lopt.value(), common);
+                return context_->make<RealLiteralNode>(start, lopt.value(), common);
             }
             lhs->setCast(common);
             return std::move(lhs);
         }
         if (lopt) {
-            return make_unique<RealLiteralNode>(start, lopt.value() / rvalue, common);
+            return context_->make<RealLiteralNode>(start, lopt.value() / rvalue, common);
         }
     }
     return std::nullopt;
@@ -1961,10 +1963,10 @@ Sema::foldSubOp(const FilePos &start, const FilePos &,
     auto ropt = literal_cast<T>(*rhs);
     if (lopt && ropt) {
         T result = lopt.value() - ropt.value();
-        return make_unique<L>(start, result, common->isInteger() ? intType(static_cast<int64_t>(result)) : common);
+        return context_->make<L>(start, result, common->isInteger() ? intType(static_cast<int64_t>(result)) : common);
     }
     if (lopt && lopt.value() == 0) {
-        return make_unique<UnaryExpressionNode>(start, OperatorType::NEG, std::move(rhs), common);
+        return context_->make<UnaryExpressionNode>(start, OperatorType::NEG, std::move(rhs), common);
     }
     if (ropt && ropt.value() == 0) {
         return std::move(lhs);
@@ -1995,9 +1997,9 @@ Sema::fold(const FilePos &start, const FilePos &end,
         if (lhs->getType()->kind() == TypeKind::NILTYPE && rhs->getType()->kind() == TypeKind::NILTYPE) {
             switch (op) {
                 case OperatorType::EQ:
-                    return make_unique<BooleanLiteralNode>(start, true, common);
+                    return context_->make<BooleanLiteralNode>(start, true, common);
                 case OperatorType::NEQ:
-                    return make_unique<BooleanLiteralNode>(start, false, common);
+                    return context_->make<BooleanLiteralNode>(start, false, common);
                 default:
                     logger_.error(start, "operator " + to_string(op) + " does not return a boolean value.");
                     return std::nullopt;
@@ -2013,13 +2015,13 @@ Sema::fold(const FilePos &start, const FilePos &end,
                         auto lvalue = lopt.value();
                         switch (op) {
                             case OperatorType::EQ:
-                                return make_unique<BooleanLiteralNode>(start, lvalue == rvalue, common);
+                                return context_->make<BooleanLiteralNode>(start, lvalue == rvalue, common);
                             case OperatorType::NEQ:
-                                return make_unique<BooleanLiteralNode>(start, lvalue != rvalue, common);
+                                return context_->make<BooleanLiteralNode>(start, lvalue != rvalue, common);
                             case OperatorType::LEQ:
-                                return make_unique<BooleanLiteralNode>(start, (lvalue & rvalue.flip()).none(), common);
+                                return context_->make<BooleanLiteralNode>(start, (lvalue & rvalue.flip()).none(), common);
                             case OperatorType::GEQ:
-                                return make_unique<BooleanLiteralNode>(start, (rvalue & lvalue.flip()).none(), common);
+                                return context_->make<BooleanLiteralNode>(start, (rvalue & lvalue.flip()).none(), common);
                             default:
                                 logger_.error(start, "operator " + to_string(op) + " does not return a boolean value.");
                                 return std::nullopt;
@@ -2027,7 +2029,7 @@ Sema::fold(const FilePos &start, const FilePos &end,
                     }
                 } else if (op == OperatorType::IN && lhs->getType()->isInteger()) {
                     const auto lvalue = assertInBounds(dynamic_cast<IntegerLiteralNode *>(lhs.get()), 0, 31);
-                    return make_unique<BooleanLiteralNode>(start, rvalue.test(static_cast<std::size_t>(lvalue)), common);
+                    return context_->make<BooleanLiteralNode>(start, rvalue.test(static_cast<std::size_t>(lvalue)), common);
                 } else {
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied here.");
                     return std::nullopt;
@@ -2067,7 +2069,7 @@ Sema::fold(const FilePos &start, const FilePos &end,
         if (lopt && ropt) {
             switch (op) {
                 case OperatorType::PLUS:
-                    return make_unique<StringLiteralNode>(start, lopt.value() + ropt.value(), common);
+                    return context_->make<StringLiteralNode>(start, lopt.value() + ropt.value(), common);
                 default:
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied to string values.");
             }
@@ -2080,13 +2082,13 @@ Sema::fold(const FilePos &start, const FilePos &end,
             auto rvalue = ropt.value();
             switch (op) {
                 case OperatorType::PLUS:
-                    return make_unique<SetLiteralNode>(start, lvalue | rvalue, common);
+                    return context_->make<SetLiteralNode>(start, lvalue | rvalue, common);
                 case OperatorType::MINUS:
-                    return make_unique<SetLiteralNode>(start, lvalue & rvalue.flip(), common);
+                    return context_->make<SetLiteralNode>(start, lvalue & rvalue.flip(), common);
                 case OperatorType::TIMES:
-                    return make_unique<SetLiteralNode>(start, lvalue & rvalue, common);
+                    return context_->make<SetLiteralNode>(start, lvalue & rvalue, common);
                 case OperatorType::DIVIDE:
-                    return make_unique<SetLiteralNode>(start, lvalue ^ rvalue, common);
+                    return context_->make<SetLiteralNode>(start, lvalue ^ rvalue, common);
                 default:
                     logger_.error(start, "operator " + to_string(op) + " cannot be applied to set values.");
             }
@@ -2114,13 +2116,13 @@ Sema::isSameIdent(Ident *aIdent, Ident *bIdent) {
 
 void
 Sema::assertUnique(const IdentDef *ident, DeclarationNode *node) const {
-    if (symbols_->isDuplicate(ident->name())) {
+    if (symbols_->isDuplicate(ident->symbol())) {
         logger_.error(ident->start(), "duplicate definition: " + ident->name() + ".");
     }
-    if (symbols_->isGlobal(ident->name())) {
+    if (symbols_->isGlobal(ident->symbol())) {
         logger_.error(ident->start(), "predefined identifier: " + ident->name() + ".");
     }
-    symbols_->insert(ident->name(), node);
+    symbols_->insert(ident->symbol(), node);
 }
 
 void
@@ -2244,6 +2246,10 @@ bool Sema::isParameterListMatching(ProcedureTypeNode *lhsTy, ProcedureTypeNode *
         err = "type mismatch: procedure types with variadic arguments are incompatible.";
         return false;
     }
+    // Procedure types are interned by the AST context, i.e., matching parameter lists share the same node.
+    if (lhsTy == rhsTy) {
+        return true;
+    }
     // 1. They have the same number of parameters.
     if (lhsTy->parameters().size() != rhsTy->parameters().size()) {
         err = "type mismatch: procedure types have different number of parameters.";
@@ -4,16 +4,49 @@
 
 #include "OberonSystem.h"
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
+using std::lock_guard;
 using std::make_unique;
+using std::map;
+using std::mutex;
 using std::pair;
 using std::string;
 using std::vector;
 
+// Basic types are shared by all instances, as imported modules are shared by all compilations through the import
+// cache and type checking compares basic types by identity.
+struct SharedBasicTypes {
+    mutex lock;
+    map<pair<TypeKind, unsigned>, unique_ptr<BasicTypeNode>> types;
+};
+
+static SharedBasicTypes &getSharedBasicTypes() {
+    static SharedBasicTypes instance;
+    return instance;
+}
+
+static BasicTypeNode *getSharedBasicType(const TypeKind kind, const unsigned size) {
+    auto &shared = getSharedBasicTypes();
+    lock_guard guard(shared.lock);
+    auto &type = shared.types[{kind, size}];
+    if (!type) {
+        type = make_unique<BasicTypeNode>(make_unique<Ident>(to_string(kind)), kind, size);
+    }
+    return type.get();
+}
+
+void OberonSystem::releaseBasicTypes() {
+    auto &shared = getSharedBasicTypes();
+    lock_guard guard(shared.lock);
+    shared.types.clear();
+}
+
 OberonSystem::~OberonSystem() = default;
 
 SymbolTable *OberonSystem::getSymbolTable() {
@@ -53,9 +86,7 @@ void OberonSystem::createBasicTypes(const vector<pair<pair<TypeKind, unsigned in
 }
 
 BasicTypeNode *OberonSystem::createBasicType(TypeKind kind, unsigned int size) {
-    auto type = make_unique<BasicTypeNode>(make_unique<Ident>(to_string(kind)), kind, size);
-    const auto ptr = type.get();
-    types_.push_back(std::move(type));
+    const auto ptr = getSharedBasicType(kind, size);
     baseTypes_[ptr->getIdentifier()->name()] = ptr;
     return ptr;
 }
@@ -36,6 +36,9 @@ public:
     void createBasicTypes(const vector<pair<pair<TypeKind, unsigned int>, bool>>&);
     BasicTypeNode *createBasicType(TypeKind, unsigned);
     BasicTypeNode *getBasicType(TypeKind);
+    // Releases the basic types shared by all instances, whose identifiers are invalidated by `Interner::reset`. Must
+    // only be called while no compilation is running and no AST is alive.
+    static void releaseBasicTypes();
 
     PointerTypeNode *createPointerType(TypeNode *);
 
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <iostream>
 #include <regex>
+#include <thread>
 
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string.hpp>
@@ -14,8 +15,11 @@
 #include "config.h"
 #include "Logger.h"
 #include "codegen/CodeGenFactory.h"
+#include "compiler/BuildScheduler.h"
+#include "compiler/CompileServer.h"
 #include "compiler/Compiler.h"
 #include "compiler/CompilerConfig.h"
+#include "LLDWrapper.h"
 
 // For certain modules, LLVM emits stack protection functionality under Windows that
 // involves calls to the standard runtime of the target platform. Since these libraries 
@@ -40,7 +44,9 @@ using std::cout;
 using std::cerr;
 using std::endl;
 using std::make_unique;
+using std::ostream;
 using std::regex;
+using std::regex_match;
 using std::regex_search;
 using std::smatch;
 using std::string;
@@ -48,9 +54,22 @@ using std::to_string;
 using std::vector;
 
 int configure(CompilerConfig& config, const po::variables_map& vm);
+int compile(const fs::path& home, const vector<string>& args, ostream& out, bool served);
+int linkExecutable(CompilerConfig& config, CodeGen& codegen);
 
 int main(const int argc, const char **argv) {
-    CompilerConfig config;
+    // Find installation directory of the compiler
+    auto home = path(argv[0]);
+    if (!home.is_absolute()) {
+        home = fs::current_path() / home;
+    }
+    home = fs::canonical(home).parent_path();
+    return compile(home, vector<string>(argv + 1, argv + argc), cout, false);
+}
+
+// Runs the compiler with the given command line arguments, either directly or as a request of the compile server.
+int compile(const fs::path& home, const vector<string>& args, ostream& out, const bool served) {
+    CompilerConfig config(out);
     // Get the logger and configure it with the program name
     Logger &logger = config.logger();
     logger.setBanner(PROGRAM_NAME);
@@ -58,17 +77,9 @@ int main(const int argc, const char **argv) {
     auto work = fs::current_path();
     logger.debug("Working directory: '" + work.string() + "'.");
     config.setWorkingDirectory(work);
-    // Find installation directory of the compiler and add it to configuration
-    auto home = path(argv[0]);
-    if (!home.is_absolute()) {
-        home = work / home;
-    }
-    home = fs::canonical(home).parent_path();
+    // Add installation directory of the compiler to configuration
     logger.debug("Installed directory: '" + home.string() + "'.");
     config.setInstallDirectory(home);
-    // Create the compiler with the LLVM code generator as back-end
-    auto codegen = CodeGenFactory::GetCodeGen(CompilerBackend::LLVM, config);
-    Compiler compiler(config, codegen.get());
     // Define command line options of the compiler
     auto visible = po::options_description("OPTIONS");
     visible.add_options()
@@ -80,11 +91,17 @@ int main(const int argc, const char **argv) {
             (",L", po::value<vector<string>>()->value_name("<directories>"), "Search paths for libraries.")
             (",l", po::value<vector<string>>()->value_name("<library>"), "Static or dynamic library.")
             (",f", po::value<vector<string>>()->value_name("<flag>"), "Compiler configuration flags.")
+            ("jobs,j", po::value<unsigned>()->value_name("<number>"), "Number of modules to compile in parallel.")
             (",O", po::value<char>()->value_name("<level>"), "Optimization level. [O0, O1, O2, O3]")
             (",o", po::value<string>()->value_name("<filename>"), "Name of the output file.")
             (",W", po::value<vector<string>>()->value_name("<option>"), "Warning configuration.")
+            (",R", po::value<vector<string>>()->value_name("<remark>"), "Optimization remarks. [pass=<regex>]")
             ("reloc", po::value<string>()->value_name("<model>"), "Set relocation model. [default, static, pic]")
             ("run,r", "Run with LLVM JIT.")
+            ("server", po::value<string>()->value_name("<socket>"), "Run as compile server listening on the socket.")
+            ("server-names", po::value<size_t>()->value_name("<number>"),
+                    "Number of interned names after which the compile server resets its caches.")
+            ("connect", po::value<string>()->value_name("<socket>"), "Forward compilation to the compile server.")
             ("sym-dir", po::value<string>()->value_name("<directory>"), "Set output path for generated .smb files.")
             (",S", "Only run compilation steps.")
             ("std", po::value<string>()->value_name("<language>"), "Language standard to compile for.")
@@ -100,7 +117,7 @@ int main(const int argc, const char **argv) {
     all.add(visible).add(hidden);
     po::variables_map vm;
     try {
-        po::store(po::command_line_parser(argc, argv)
+        po::store(po::command_line_parser(args)
             .options(all)
             .positional(p)
             .run(),
@@ -111,21 +128,51 @@ int main(const int argc, const char **argv) {
     }
     po::notify(vm);
     if (vm.count("help")) {
-        cout << "OVERVIEW: " << PROGRAM_NAME << " LLVM compiler\n" << endl;
-        cout << "USAGE: " << PROGRAM_NAME << " [options] file...\n" << endl;
-        cout << visible << endl;
+        out << "OVERVIEW: " << PROGRAM_NAME << " LLVM compiler\n" << endl;
+        out << "USAGE: " << PROGRAM_NAME << " [options] file...\n" << endl;
+        out << visible << endl;
         return EXIT_SUCCESS;
     }
+    if (served && (vm.count("server") || vm.count("connect") || vm.count("run"))) {
+        logger.error(PROGRAM_NAME, "arguments '--server', '--connect', and '--run' are not supported by the server.");
+        return EXIT_FAILURE;
+    }
+    if (vm.count("server")) {
+        // Keep the compiler resident: the back-end and the import cache are reused by all requests
+        const auto names = vm.count("server-names") ? vm["server-names"].as<size_t>() : CompileServer::MAX_NAMES;
+        CompileServer server(logger, vm["server"].as<string>(), names);
+        return server.serve([&home](const vector<string>& request, ostream& os) {
+            return compile(home, request, os, true);
+        });
+    }
+    if (vm.count("connect")) {
+        // Forward the command line without the socket to the compile server
+        vector<string> request;
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (args[i] == "--connect") {
+                ++i;
+            } else if (!args[i].starts_with("--connect=")) {
+                request.push_back(args[i]);
+            }
+        }
+        if (const auto status = CompileServer::forward(vm["connect"].as<string>(), request, out)) {
+            return status.value();
+        }
+        logger.debug("Compile server not available, compiling locally.");
+    }
+    // Create the compiler with the LLVM code generator as back-end
+    auto codegen = CodeGenFactory::GetCodeGen(CompilerBackend::LLVM, config);
+    Compiler compiler(config, codegen.get());
     if (vm.count("version")) {
-        cout << PROGRAM_NAME << " version " << PROJECT_VERSION;
-        cout << " (" << GIT_COMMIT << "@" << GIT_BRANCH << ")" << endl;
-        cout << "Target:   " << codegen->getDescription() << endl;
-        cout << "Install:  " << config.getInstallDirectory().string() << endl;
-        cout << "Includes: ";
-        cout << "Boost " << BOOST_VERSION / 100000 << "."
-                         << BOOST_VERSION / 100 % 1000 << "."
-                         << BOOST_VERSION % 100 << ", ";
-        cout << "LLVM " << LLVM_VERSION << endl;
+        out << PROGRAM_NAME << " version " << PROJECT_VERSION;
+        out << " (" << GIT_COMMIT << "@" << GIT_BRANCH << ")" << endl;
+        out << "Target:   " << codegen->getDescription() << endl;
+        out << "Install:  " << config.getInstallDirectory().string() << endl;
+        out << "Includes: ";
+        out << "Boost " << BOOST_VERSION / 100000 << "."
+                        << BOOST_VERSION / 100 % 1000 << "."
+                        << BOOST_VERSION % 100 << ", ";
+        out << "LLVM " << LLVM_VERSION << endl;
         return EXIT_SUCCESS;
     }
     if (configure(config, vm) == EXIT_SUCCESS) {
@@ -148,20 +195,71 @@ int main(const int argc, const char **argv) {
             return EXIT_FAILURE;
 #endif
         }
-        for (auto &input : inputs) {
-            logger.debug("Compiling module " + to_string(input) + ".");
-            compiler.compile(input);
+        if (config.getJobs() > 1 && inputs.size() > 1) {
+            BuildScheduler scheduler(config, out);
+            scheduler.compile(inputs, config.getJobs());
+        } else {
+            for (auto &input : inputs) {
+                if (config.getFileType() == OutputFileType::ExecutableFile) {
+                    // The last module is the main module of the executable
+                    config.toggleFlag(Flag::ENABLE_MAIN, &input == &inputs.back());
+                }
+                logger.debug("Compiling module " + to_string(input) + ".");
+                compiler.compile(input);
+            }
         }
-        string status = logger.getErrorCount() == 0 ? "complete" : "failed";
+        int result = logger.getErrorCount() != 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+        if (config.getFileType() == OutputFileType::ExecutableFile && result == EXIT_SUCCESS) {
+            result = linkExecutable(config, *codegen);
+        }
+        string status = result == EXIT_SUCCESS ? "complete" : "failed";
         logger.info("Compilation " + status + ": " +
                     to_string(logger.getErrorCount()) + " error(s), " +
                     to_string(logger.getWarningCount()) + " warning(s), " +
                     to_string(logger.getInfoCount()) + " message(s).");
-        exit(logger.getErrorCount() != 0);
+        return result;
     }
     return EXIT_FAILURE;
 }
 
+// Links the object files of the input modules and the libraries to an executable. The executable is named after the
+// output file, if one is given, or after the main module otherwise.
+int linkExecutable(CompilerConfig& config, CodeGen& codegen) {
+    Logger& logger = config.logger();
+    const auto triple = config.getTargetTriple();
+    LLDWrapper linker(logger, triple.empty() ? codegen.getDescription() : triple);
+    for (const auto& directory : config.getLibraryDirectories()) {
+        linker.addLibraryDirectory(directory);
+    }
+    for (const auto& library : config.getLibraries()) {
+        linker.addLibrary(library);
+    }
+    if (config.hasFlag(Flag::LTO)) {
+        unsigned level;
+        switch (config.getOptimizationLevel()) {
+            case OptimizationLevel::O0: level = 0; break;
+            case OptimizationLevel::O1: level = 1; break;
+            case OptimizationLevel::O3: level = 3; break;
+            default: level = 2; break;
+        }
+        linker.setLTO(level, config.getJobs());
+    }
+    linker.setProfile(config.hasFlag(Flag::PROFILE_GENERATE));
+    vector<fs::path> objects;
+    for (const auto& input : config.getInputFiles()) {
+        objects.push_back(codegen.getOutputFile(fs::absolute(input)));
+    }
+    fs::path output = config.getOutputFile();
+    if (output.empty()) {
+        output = fs::path(config.getInputFiles().back()).filename().replace_extension("");
+#if defined(_WIN32) || defined(_WIN64)
+        output.replace_extension("exe");
+#endif
+    }
+    logger.debug("Linking executable " + to_string(output) + ".");
+    return linker.link(objects, output) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int configure(CompilerConfig& config, const po::variables_map& vm) {
     Logger& logger = config.logger();
     // Parse command line options
@@ -224,6 +322,44 @@ int configure(CompilerConfig& config, const po::variables_map& vm) {
                 config.setFlag(Flag::ENABLE_VARARGS);
             } else if (flag == "enable-main") {
                 config.setFlag(Flag::ENABLE_MAIN);
+            } else if (flag == "incremental") {
+                config.setFlag(Flag::INCREMENTAL);
+            } else if (flag == "gc") {
+                config.setFlag(Flag::GARBAGE_COLLECT);
+            } else if (flag == "defer-overflow-trap") {
+                config.setFlag(Flag::DEFER_OVERFLOW);
+            } else if (flag == "jit=tiered") {
+                config.setFlag(Flag::TIERED_JIT);
+            } else if (flag == "lto" || flag == "lto=thin") {
+                config.setFlag(Flag::LTO);
+            } else if (flag == "profile-generate" || flag.starts_with("profile-generate=")) {
+                if (!config.getProfileFile().empty() && !config.hasFlag(Flag::PROFILE_GENERATE)) {
+                    logger.error(PROGRAM_NAME, "argument '-fprofile-generate' cannot be used with '-fprofile-use'.");
+                    return EXIT_FAILURE;
+                }
+                // Every executable writes its profile to a separate raw profile in the given directory
+                const auto pos = flag.find('=');
+                const auto dir = fs::path(pos == string::npos ? "" : flag.substr(pos + 1));
+                config.setFlag(Flag::PROFILE_GENERATE);
+                config.setProfileFile((dir / "default_%m.profraw").string());
+            } else if (flag.starts_with("profile-use=")) {
+                if (config.hasFlag(Flag::PROFILE_GENERATE)) {
+                    logger.error(PROGRAM_NAME, "argument '-fprofile-use' cannot be used with '-fprofile-generate'.");
+                    return EXIT_FAILURE;
+                }
+                auto file = fs::path(flag.substr(flag.find('=') + 1));
+                if (fs::is_directory(file)) {
+                    file /= "default.profdata";
+                }
+                if (!fs::exists(file)) {
+                    logger.error(PROGRAM_NAME, "profile file not found: '" + file.string() + "'.");
+                    return EXIT_FAILURE;
+                }
+                config.setProfileFile(file.string());
+            } else if (flag == "allocator=pool") {
+                config.setFlag(Flag::POOL_ALLOCATOR);
+            } else if (flag == "allocator=malloc") {
+                config.toggleFlag(Flag::POOL_ALLOCATOR, false);
             } else if (flag == "no-stack-protector") {
                 config.toggleFlag(Flag::STACK_PROTECT, false);
             } else if (smatch matches; regex_search(flag, matches, regex("^(no-)?init-(local|global)-zero$"))) {
@@ -293,10 +429,24 @@ int configure(CompilerConfig& config, const po::variables_map& vm) {
                 } else {
                     logger.warning(PROGRAM_NAME, "ignoring unrecognized argument: '-f" + flag + "'.");
                 }
+            } else if (regex_search(flag, matches, regex("^jit-threshold=([1-9][0-9]{0,8})$"))) {
+                config.setJitThreshold(static_cast<unsigned>(std::stoul(matches.str(1))));
+            } else if (regex_search(flag, matches, regex("^codegen-partitions=([0-9]{1,4})$"))) {
+                auto partitions = static_cast<unsigned>(std::stoul(matches.str(1)));
+                if (partitions == 0) {
+                    // Use as many partitions as there are hardware threads
+                    partitions = std::thread::hardware_concurrency();
+                }
+                config.setPartitions(partitions == 0 ? 1 : partitions);
             } else {
                 logger.warning(PROGRAM_NAME, "ignoring unrecognized argument: '-f" + flag + "'.");
             }
         }
+        if (config.hasFlag(Flag::GARBAGE_COLLECT) && config.hasFlag(Flag::POOL_ALLOCATOR)) {
+            // The collector manages its own heap, pool blocks would neither be traced nor freed
+            logger.error(PROGRAM_NAME, "argument '-fallocator=pool' cannot be used with '-fgc'.");
+            return EXIT_FAILURE;
+        }
     }
     if (vm.count("-O")) {
         switch (auto level = vm["-O"].as<char>()) {
@@ -325,6 +475,14 @@ int configure(CompilerConfig& config, const po::variables_map& vm) {
                 return EXIT_FAILURE;
         }
     }
+    if (vm.count("jobs")) {
+        auto jobs = vm["jobs"].as<unsigned>();
+        if (jobs == 0) {
+            // Use as many jobs as there are hardware threads
+            jobs = std::thread::hardware_concurrency();
+        }
+        config.setJobs(jobs == 0 ? 1 : jobs);
+    }
     if (vm.count("-o")) {
         config.setOutputFile(vm["-o"].as<string>());
     }
@@ -339,6 +497,28 @@ int configure(CompilerConfig& config, const po::variables_map& vm) {
             }
         }
     }
+    if (vm.count("-R")) {
+        const auto params = vm["-R"].as<vector<string>>();
+        for (const auto& remark : params) {
+            smatch matches;
+            if (!regex_search(remark, matches, regex("^pass=(.*)$"))) {
+                logger.warning(PROGRAM_NAME, "ignoring unrecognized remark: '-R" + remark + "'.");
+                continue;
+            }
+            try {
+                // Report the remarks of the passes whose name matches the regular expression
+                const regex pass(matches.str(1));
+                if (regex_match("bounds-check", pass)) {
+                    config.setRemark(Remark::BOUNDS_CHECK);
+                }
+                if (regex_match("overflow-check", pass)) {
+                    config.setRemark(Remark::OVERFLOW_CHECK);
+                }
+            } catch (const std::regex_error &) {
+                logger.warning(PROGRAM_NAME, "ignoring invalid regular expression: '-R" + remark + "'.");
+            }
+        }
+    }
     if (vm.count("run")) {  // run
         config.setJit(true);
     } else if (vm.count("-c")) {  // compile and assemble
@@ -353,11 +533,18 @@ int configure(CompilerConfig& config, const po::variables_map& vm) {
         } else {
             config.setFileType(OutputFileType::AssemblyFile);
         }
-    } else {
+    } else {  // compile, assemble, and link
         if (vm.count("emit-llvm")) {
             logger.error(PROGRAM_NAME, "argument '--emit-llvm' cannot be used when linking.");
+            return EXIT_FAILURE;
         }
-        logger.error(PROGRAM_NAME, "linking not yet supported.");
+        config.setFileType(OutputFileType::ExecutableFile);
+    }
+    if (!config.isJit() && config.hasFlag(Flag::TIERED_JIT)) {
+        logger.warning(PROGRAM_NAME, "argument unused during compilation: '-fjit=tiered'.");
+    }
+    if (config.isJit() && config.hasFlag(Flag::PROFILE_GENERATE)) {
+        logger.error(PROGRAM_NAME, "argument '-fprofile-generate' is not supported in JIT mode.");
         return EXIT_FAILURE;
     }
     if (vm.count("reloc")) {
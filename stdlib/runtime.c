@@ -4,10 +4,12 @@
 
 #include "runtime.h"
 
+#include <errno.h>
 #include <inttypes.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <sys/stat.h>
 
@@ -15,6 +17,9 @@
   #include <io.h>
   #include <windows.h>
 #else
+  #include <fcntl.h>
+  #include <signal.h>
+  #include <sys/mman.h>
   #include <unistd.h>
 #endif
 
@@ -22,6 +27,430 @@
 
 #define UNUSED(x) (void)(x)
 
+#if defined(_MSC_VER)
+  #define THREAD_LOCAL __declspec(thread)
+#else
+  #define THREAD_LOCAL _Thread_local
+#endif
+
+// Pool allocator used by `NEW` and `DISPOSE` if the program was compiled with `-fallocator=pool`. Small blocks
+// are bump-allocated from slabs that serve a single size class and are recycled through a thread-local free list
+// per size class. Slabs are aligned to their size, so that the header of the slab, and hence the size class of a
+// block, is found by masking the address of the block. Blocks of a size class are aligned to 16 bytes. Large blocks
+// are allocated individually and follow a header of 8 bytes, which tells them apart from blocks of a size class, as
+// no type of Oberon requires an alignment of more than 8 bytes. A block that is freed by another thread than the
+// one that allocated it is recycled by the freeing thread. Blocks have to be freed by the allocator that allocated
+// them: modules compiled with and without `-fallocator=pool` must not exchange pointers that are passed to `DISPOSE`.
+#define POOL_SLAB_SIZE ((size_t) 64 * 1024)
+#define POOL_SLAB_HEADER ((size_t) 64)
+#define POOL_CLASS_SIZE ((size_t) 16)
+#define POOL_CLASS_COUNT ((size_t) 32)
+#define POOL_LARGE_HEADER ((size_t) 8)
+
+typedef struct {
+    size_t cls;
+} pool_slab;
+
+typedef struct {
+    void *free[POOL_CLASS_COUNT];
+    char *next[POOL_CLASS_COUNT];
+    char *end[POOL_CLASS_COUNT];
+} pool_state;
+
+static THREAD_LOCAL pool_state pool;
+
+static void *pool_aligned_alloc(const size_t size, const size_t alignment) {
+#if defined(_WIN32) || defined(_WIN64)
+    return _aligned_malloc(size, alignment);
+#else
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        return NULL;
+    }
+    return ptr;
+#endif
+}
+
+static void pool_aligned_free(void *ptr) {
+#if defined(_WIN32) || defined(_WIN64)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void *olang_rt_alloc(const int64_t size) {
+    if (size > (int64_t) (POOL_CLASS_SIZE * POOL_CLASS_COUNT)) {
+        char *ptr = pool_aligned_alloc(POOL_LARGE_HEADER + (size_t) size, POOL_CLASS_SIZE);
+        if (ptr == NULL) {
+            return NULL;
+        }
+        return ptr + POOL_LARGE_HEADER;
+    }
+    const size_t cls = size > 0 ? ((size_t) size - 1) / POOL_CLASS_SIZE : 0;
+    void *block = pool.free[cls];
+    if (block != NULL) {
+        pool.free[cls] = *(void **) block;
+        return block;
+    }
+    const size_t bytes = (cls + 1) * POOL_CLASS_SIZE;
+    if (pool.next[cls] == pool.end[cls]) {
+        pool_slab *slab = pool_aligned_alloc(POOL_SLAB_SIZE, POOL_SLAB_SIZE);
+        if (slab == NULL) {
+            return NULL;
+        }
+        slab->cls = cls;
+        pool.next[cls] = (char *) slab + POOL_SLAB_HEADER;
+        pool.end[cls] = pool.next[cls] + (POOL_SLAB_SIZE - POOL_SLAB_HEADER) / bytes * bytes;
+    }
+    block = pool.next[cls];
+    pool.next[cls] += bytes;
+    return block;
+}
+
+void olang_rt_free(void *block) {
+    if (block == NULL) {
+        return;
+    }
+    if ((uintptr_t) block % POOL_CLASS_SIZE == POOL_LARGE_HEADER) {
+        pool_aligned_free((char *) block - POOL_LARGE_HEADER);
+        return;
+    }
+    const pool_slab *slab = (pool_slab *) ((uintptr_t) block & ~(uintptr_t) (POOL_SLAB_SIZE - 1));
+    const size_t cls = slab->cls;
+    *(void **) block = pool.free[cls];
+    pool.free[cls] = block;
+}
+
+// Compares two strings up to their terminating 0X or the end of the shorter array, whichever comes first. The end of
+// an array is compared as 0X. Characters are compared eight at a time, as long as no 0X is found among them.
+int32_t olang_rt_strcmp_n(const char *lhs, const int64_t lhsLen, const char *rhs, const int64_t rhsLen) {
+    const int64_t len = lhsLen < rhsLen ? lhsLen : rhsLen;
+    int64_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t l, r;
+        memcpy(&l, lhs + i, sizeof(l));
+        memcpy(&r, rhs + i, sizeof(r));
+        if (l != r || ((l - 0x0101010101010101ULL) & ~l & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    for (; i < len; ++i) {
+        const unsigned char l = (unsigned char) lhs[i];
+        const unsigned char r = (unsigned char) rhs[i];
+        if (l != r) {
+            return (int32_t) l - (int32_t) r;
+        }
+        if (l == 0) {
+            return 0;
+        }
+    }
+    if (lhsLen < rhsLen) {
+        return -(int32_t) (unsigned char) rhs[len];
+    }
+    if (lhsLen > rhsLen) {
+        return (int32_t) (unsigned char) lhs[len];
+    }
+    return 0;
+}
+
+// Precise mark-and-sweep garbage collector used by `NEW` if the program was compiled with `-fgc`. Every block is
+// preceded by a header that holds the pointer map of the block, i.e., the offsets of the pointers it contains, as
+// emitted by the compiler. The roots of the collector are the global variables registered by the module bodies and
+// the local variables registered on the shadow stack that LLVM maintains for functions using the `shadow-stack`
+// strategy. The set of blocks is kept in a hash table, so that pointers to memory that has not been allocated by
+// the collector, e.g., by modules that were not compiled with `-fgc`, are never traced. The collector is not
+// thread-safe.
+typedef struct {
+    int64_t count;
+    int64_t offsets[];
+} gc_map;
+
+typedef struct {
+    const gc_map *map;
+    uint64_t size;  // size of the block shifted by one, the lowest bit is the mark
+} gc_header;
+
+typedef struct {
+    void *slot;
+    const gc_map *map;
+} gc_global;
+
+typedef struct {
+    int32_t roots;
+    int32_t meta;
+    const gc_map *maps[];
+} gc_frame_map;
+
+typedef struct gc_frame {
+    struct gc_frame *next;
+    const gc_frame_map *map;
+    void *roots[];
+} gc_frame;
+
+#define GC_TOMBSTONE ((void *) 1)
+#define GC_HEAP_SIZE ((int64_t) 8 * 1024 * 1024)
+
+static struct {
+    gc_frame **chain;
+    void **blocks;
+    size_t capacity;
+    size_t used;
+    const gc_global **globals;
+    int64_t *counts;
+    size_t modules;
+    gc_header **stack;
+    size_t depth;
+    size_t limit;
+    int64_t heap;
+    int64_t threshold;
+    int64_t since;
+    bool initialized;
+    olang_gc_statistics stats;
+} gc;
+
+static size_t gc_hash(const void *block) {
+    return (size_t) (((uintptr_t) block >> 4) * (uintptr_t) 0x9e3779b97f4a7c15ULL);
+}
+
+// Rebuilds the hash table with the given capacity, which also removes the tombstones of freed blocks
+static bool gc_resize(const size_t capacity) {
+    void **blocks = calloc(capacity, sizeof(void *));
+    if (blocks == NULL) {
+        return false;
+    }
+    size_t used = 0;
+    for (size_t i = 0; i < gc.capacity; ++i) {
+        if (gc.blocks[i] != NULL && gc.blocks[i] != GC_TOMBSTONE) {
+            size_t j = gc_hash(gc.blocks[i]) & (capacity - 1);
+            while (blocks[j] != NULL) {
+                j = (j + 1) & (capacity - 1);
+            }
+            blocks[j] = gc.blocks[i];
+            ++used;
+        }
+    }
+    free((void *) gc.blocks);
+    gc.blocks = blocks;
+    gc.capacity = capacity;
+    gc.used = used;
+    return true;
+}
+
+static bool gc_insert(void *block) {
+    if ((gc.used + 1) * 4 > gc.capacity * 3 && !gc_resize(gc.capacity ? gc.capacity * 2 : 1024)) {
+        return false;
+    }
+    size_t i = gc_hash(block) & (gc.capacity - 1);
+    while (gc.blocks[i] != NULL) {
+        i = (i + 1) & (gc.capacity - 1);
+    }
+    gc.blocks[i] = block;
+    ++gc.used;
+    return true;
+}
+
+static void **gc_find(const void *block) {
+    if (gc.capacity == 0) {
+        return NULL;
+    }
+    size_t i = gc_hash(block) & (gc.capacity - 1);
+    while (gc.blocks[i] != NULL) {
+        if (gc.blocks[i] == block) {
+            return &gc.blocks[i];
+        }
+        i = (i + 1) & (gc.capacity - 1);
+    }
+    return NULL;
+}
+
+static void gc_mark(void *const *slot) {
+    void *block = *slot;
+    if (block == NULL || gc_find(block) == NULL) {
+        return;
+    }
+    gc_header *header = (gc_header *) block - 1;
+    if (header->size & 1) {
+        return;
+    }
+    header->size |= 1;
+    if (header->map == NULL) {
+        return;
+    }
+    if (gc.depth == gc.limit) {
+        const size_t limit = gc.limit ? gc.limit * 2 : 256;
+        gc_header **stack = realloc((void *) gc.stack, limit * sizeof(gc_header *));
+        if (stack == NULL) {
+            fprintf(stderr, "olang: out of memory while collecting garbage.\n");
+            abort();
+        }
+        gc.stack = stack;
+        gc.limit = limit;
+    }
+    gc.stack[gc.depth++] = header;
+}
+
+static void gc_mark_map(char *base, const gc_map *map) {
+    for (int64_t i = 0; i < map->count; ++i) {
+        gc_mark((void *const *) (base + map->offsets[i]));
+    }
+}
+
+static int64_t gc_nanos(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void gc_exit(void) {
+    const olang_gc_statistics *s = &gc.stats;
+    fprintf(stderr, "olang: %" PRId64 " collections in %" PRId64 " us, %" PRId64 " bytes allocated, %" PRId64
+            " bytes freed, %" PRId64 " bytes in %" PRId64 " live objects.\n", s->collections, s->time / 1000,
+            s->allocated, s->freed, s->heap, s->objects);
+}
+
+static void gc_init(void) {
+    const char *size = getenv("OLANG_GC_HEAP");
+    gc.threshold = size != NULL ? strtoll(size, NULL, 10) : 0;
+    if (gc.threshold <= 0) {
+        gc.threshold = GC_HEAP_SIZE;
+    }
+    if (getenv("OLANG_GC_STATS") != NULL) {
+        atexit(gc_exit);
+    }
+    gc.initialized = true;
+}
+
+void olang_gc_register(void *chain, const void *globals, const int64_t count) {
+    gc.chain = chain;
+    if (count == 0) {
+        return;
+    }
+    for (size_t i = 0; i < gc.modules; ++i) {
+        if (gc.globals[i] == globals) {
+            return;
+        }
+    }
+    const gc_global **modules = realloc((void *) gc.globals, (gc.modules + 1) * sizeof(gc_global *));
+    int64_t *counts = realloc(gc.counts, (gc.modules + 1) * sizeof(int64_t));
+    if (modules != NULL) {
+        gc.globals = modules;
+    }
+    if (counts != NULL) {
+        gc.counts = counts;
+    }
+    if (modules == NULL || counts == NULL) {
+        fprintf(stderr, "olang: out of memory while registering global variables.\n");
+        abort();
+    }
+    gc.globals[gc.modules] = globals;
+    gc.counts[gc.modules] = count;
+    ++gc.modules;
+}
+
+void *olang_gc_alloc(const int64_t size, const void *map) {
+    if (!gc.initialized) {
+        gc_init();
+    }
+    if (gc.since >= gc.threshold && gc.since >= gc.heap) {
+        olang_gc_collect();
+    }
+    gc_header *header = calloc(1, sizeof(gc_header) + (size_t) size);
+    if (header == NULL) {
+        olang_gc_collect();
+        header = calloc(1, sizeof(gc_header) + (size_t) size);
+    }
+    if (header == NULL || !gc_insert(header + 1)) {
+        free(header);
+        return NULL;
+    }
+    header->map = map;
+    header->size = (uint64_t) size << 1;
+    gc.since += size;
+    gc.stats.allocated += size;
+    gc.stats.heap += size;
+    gc.stats.objects++;
+    return header + 1;
+}
+
+void olang_gc_free(void *block) {
+    if (block == NULL) {
+        return;
+    }
+    void **entry = gc_find(block);
+    if (entry == NULL) {
+        // Memory that has not been allocated by the collector
+        free(block);
+        return;
+    }
+    *entry = GC_TOMBSTONE;
+    gc_header *header = (gc_header *) block - 1;
+    const int64_t size = (int64_t) (header->size >> 1);
+    gc.stats.freed += size;
+    gc.stats.heap -= size;
+    gc.stats.objects--;
+    free(header);
+}
+
+void olang_gc_collect(void) {
+    const int64_t start = gc_nanos();
+    // Mark the blocks that are reachable from the global variables
+    for (size_t i = 0; i < gc.modules; ++i) {
+        for (int64_t j = 0; j < gc.counts[i]; ++j) {
+            const gc_global *global = &gc.globals[i][j];
+            if (global->map == NULL) {
+                gc_mark(global->slot);
+            } else {
+                gc_mark_map(global->slot, global->map);
+            }
+        }
+    }
+    // Mark the blocks that are reachable from the local variables, a root with a map holds the address of a
+    // structured variable rather than a pointer
+    for (const gc_frame *frame = gc.chain ? *gc.chain : NULL; frame != NULL; frame = frame->next) {
+        for (int32_t i = 0; i < frame->map->roots; ++i) {
+            if (i < frame->map->meta && frame->map->maps[i] != NULL) {
+                gc_mark_map(frame->roots[i], frame->map->maps[i]);
+            } else {
+                gc_mark(&frame->roots[i]);
+            }
+        }
+    }
+    while (gc.depth > 0) {
+        const gc_header *header = gc.stack[--gc.depth];
+        gc_mark_map((char *) (header + 1), header->map);
+    }
+    // Sweep the blocks that have not been marked
+    for (size_t i = 0; i < gc.capacity; ++i) {
+        void *block = gc.blocks[i];
+        if (block == NULL || block == GC_TOMBSTONE) {
+            continue;
+        }
+        gc_header *header = (gc_header *) block - 1;
+        if (header->size & 1) {
+            header->size &= ~(uint64_t) 1;
+        } else {
+            const int64_t size = (int64_t) (header->size >> 1);
+            gc.stats.freed += size;
+            gc.stats.heap -= size;
+            gc.stats.objects--;
+            gc.blocks[i] = GC_TOMBSTONE;
+            free(header);
+        }
+    }
+    if (gc.capacity > 0) {
+        gc_resize(gc.capacity);
+    }
+    gc.since = 0;
+    gc.heap = gc.stats.heap;
+    gc.stats.collections++;
+    gc.stats.time += gc_nanos() - start;
+}
+
+void olang_gc_stats(olang_gc_statistics *stats) {
+    *stats = gc.stats;
+}
+
 bool olang_files_fexists(const char *name) {
 #if defined(_WIN32) || defined(_WIN64)
     return _access(name, 0) == 0;
@@ -55,6 +484,79 @@ bool olang_files_fseek(FILE *file, const int64_t offset) {
     return fseek(file, (long) offset, SEEK_SET) == 0;
 }
 
+// Reads up to `n` bytes at position `pos` of the file into the buffer at offset `off`. Returns the number of bytes
+// read, or -1 if the position cannot be reached.
+int64_t olang_files_fread(FILE *file, const int64_t pos, uint8_t *buf, const int64_t off, const int64_t n) {
+    if (fseek(file, (long) pos, SEEK_SET) != 0) {
+        return -1;
+    }
+    return (int64_t) fread(buf + off, 1, (size_t) n, file);
+}
+
+// Writes `n` bytes of the buffer at offset `off` to position `pos` of the file.
+bool olang_files_fwrite(FILE *file, const int64_t pos, const uint8_t *buf, const int64_t off, const int64_t n) {
+    if (fseek(file, (long) pos, SEEK_SET) != 0) {
+        return false;
+    }
+    return fwrite(buf + off, 1, (size_t) n, file) == (size_t) n;
+}
+
+void olang_files_copy(uint8_t *dst, const int64_t dstOff, const uint8_t *src, const int64_t srcOff, const int64_t n) {
+    memcpy(dst + dstOff, src + srcOff, (size_t) n);
+}
+
+// Maps the file with the given name into memory for reading and stores its length. Returns the address of the
+// mapping, or 0 if the file cannot be mapped, e.g., because it is empty or not a regular file.
+int64_t olang_files_mmap(const char *name, int64_t *length) {
+    void *addr = NULL;
+#if defined(_WIN32) || defined(_WIN64)
+    const HANDLE file = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                    NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        const HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL) {
+            addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            *length = size.QuadPart;
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(name, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat result;
+    if (fstat(fd, &result) == 0 && S_ISREG(result.st_mode) && result.st_size > 0) {
+        addr = mmap(NULL, (size_t) result.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            addr = NULL;
+        } else {
+            *length = (int64_t) result.st_size;
+        }
+    }
+    close(fd);
+#endif
+    return (int64_t) (intptr_t) addr;
+}
+
+void olang_files_munmap(const int64_t addr, const int64_t length) {
+#if defined(_WIN32) || defined(_WIN64)
+    UNUSED(length);
+    UnmapViewOfFile((void *) (intptr_t) addr);
+#else
+    munmap((void *) (intptr_t) addr, (size_t) length);
+#endif
+}
+
+void olang_files_mcopy(uint8_t *dst, const int64_t off, const int64_t src, const int64_t n) {
+    memcpy(dst + off, (const uint8_t *) (intptr_t) src, (size_t) n);
+}
+
 void olang_files_fdate(const char *name, int64_t *t, int64_t *d) {
     struct stat result;
     const int error = stat(name, &result);
@@ -67,36 +569,707 @@ void olang_files_fdate(const char *name, int64_t *t, int64_t *d) {
     }
 }
 
+// Registers the procedure of module `Files` that writes the page buffers of the open files back as the program exits,
+// which is called through the run-time library, as `atexit` may not be available to the JIT.
+void olang_files_atexit(void (*hook)(void)) {
+    atexit(hook);
+}
+
+// Conversions between numbers and their decimal representation used by modules `In`, `Reals` and `Texts`. Integers
+// are converted two digits at a time using a table of the pairs of decimal digits. Floating-point numbers are
+// formatted with the fewest digits that read back as the same number using Ryu, see Ulf Adams: "Ryu: Fast
+// Float-to-String Conversion", PLDI 2018. The 125-bit approximations of the powers of five required by Ryu are
+// computed from every 26th power and the powers 5^0 to 5^25, which are exact in 64 bits. The two bits per power in
+// `FMT_POW5_OFFSETS` and `FMT_POW5_INV_OFFSETS` correct the rounding error of the computation.
+static const char FMT_DIGITS[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+static const uint64_t FMT_POW5[26] = {
+    UINT64_C(1), UINT64_C(5), UINT64_C(25),
+    UINT64_C(125), UINT64_C(625), UINT64_C(3125),
+    UINT64_C(15625), UINT64_C(78125), UINT64_C(390625),
+    UINT64_C(1953125), UINT64_C(9765625), UINT64_C(48828125),
+    UINT64_C(244140625), UINT64_C(1220703125), UINT64_C(6103515625),
+    UINT64_C(30517578125), UINT64_C(152587890625), UINT64_C(762939453125),
+    UINT64_C(3814697265625), UINT64_C(19073486328125), UINT64_C(95367431640625),
+    UINT64_C(476837158203125), UINT64_C(2384185791015625), UINT64_C(11920928955078125),
+    UINT64_C(59604644775390625), UINT64_C(298023223876953125),
+};
+static const uint64_t FMT_POW5_SPLIT[13][2] = {
+    { UINT64_C(0), UINT64_C(1152921504606846976) },
+    { UINT64_C(0), UINT64_C(1490116119384765625) },
+    { UINT64_C(1032610780636961552), UINT64_C(1925929944387235853) },
+    { UINT64_C(7910200175544436838), UINT64_C(1244603055572228341) },
+    { UINT64_C(16941905809032713930), UINT64_C(1608611746708759036) },
+    { UINT64_C(13024893955298202172), UINT64_C(2079081953128979843) },
+    { UINT64_C(6607496772837067824), UINT64_C(1343575221513417750) },
+    { UINT64_C(17332926989895652603), UINT64_C(1736530273035216783) },
+    { UINT64_C(13037379183483547984), UINT64_C(2244412773384604712) },
+    { UINT64_C(1605989338741628675), UINT64_C(1450417759929778918) },
+    { UINT64_C(9630225068416591280), UINT64_C(1874621017369538693) },
+    { UINT64_C(665883850346957067), UINT64_C(1211445438634777304) },
+    { UINT64_C(14931890668723713708), UINT64_C(1565756531257009982) },
+};
+static const uint64_t FMT_POW5_INV_SPLIT[15][2] = {
+    { UINT64_C(0), UINT64_C(2305843009213693952) },
+    { UINT64_C(5955668970331000883), UINT64_C(1784059615882449851) },
+    { UINT64_C(8982663654677661701), UINT64_C(1380349269358112757) },
+    { UINT64_C(7286864317269821293), UINT64_C(2135987035920910082) },
+    { UINT64_C(7005857020398200552), UINT64_C(1652639921975621497) },
+    { UINT64_C(17965325103354776696), UINT64_C(1278668206209430417) },
+    { UINT64_C(8928596168509315047), UINT64_C(1978643211784836272) },
+    { UINT64_C(10075671573058298857), UINT64_C(1530901034580419511) },
+    { UINT64_C(597001226353042381), UINT64_C(1184477304306571148) },
+    { UINT64_C(1527430471115325345), UINT64_C(1832889850782397517) },
+    { UINT64_C(12533209867169019541), UINT64_C(1418129833677084982) },
+    { UINT64_C(5577825024675947041), UINT64_C(2194449627517475473) },
+    { UINT64_C(11006974540203867550), UINT64_C(1697873161311732311) },
+    { UINT64_C(10313493231639821581), UINT64_C(1313665730009899186) },
+    { UINT64_C(12701016819766672772), UINT64_C(2032799256770390445) },
+};
+static const uint32_t FMT_POW5_OFFSETS[21] = {
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x40000000, 0x59695995,
+    0x55545555, 0x56555515, 0x41150504, 0x40555410, 0x44555145, 0x44504540,
+    0x45555550, 0x40004000, 0x96440440, 0x55565565, 0x54454045, 0x40154151,
+    0x55559155, 0x51405555, 0x00000105,
+};
+static const uint32_t FMT_POW5_INV_OFFSETS[22] = {
+    0xa9a99aa9, 0x595aaa9a, 0x65596555, 0x55955969, 0x95565555, 0x966aaaaa,
+    0x555559a9, 0x55565599, 0x95555555, 0x99555596, 0xa59a99a5, 0xaaaa55a9,
+    0xa6baaaa9, 0x95559555, 0x56555556, 0x55565a55, 0xa6a6a966, 0x5aaaaaa9,
+    0xa5966a55, 0x95595555, 0x5a595665, 0x00000555,
+};
+
+// Powers of ten that are exact in double precision.
+static const double FMT_TEN[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Writes the decimal digits of `x` to the characters before `end` and returns their number.
+static size_t fmt_uint(char *end, uint64_t x) {
+    char *p = end;
+    while (x >= 100) {
+        p -= 2;
+        memcpy(p, FMT_DIGITS + (x % 100) * 2, 2);
+        x /= 100;
+    }
+    if (x >= 10) {
+        p -= 2;
+        memcpy(p, FMT_DIGITS + x * 2, 2);
+    } else {
+        *--p = (char) ('0' + x);
+    }
+    return (size_t) (end - p);
+}
+
+static inline int32_t fmt_pow5bits(const int32_t e) {
+    return ((e * 1217359) >> 19) + 1;
+}
+
+static inline uint64_t fmt_umul128(const uint64_t a, const uint64_t b, uint64_t *hi) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128_t;
+    const uint128_t p = (uint128_t) a * b;
+    *hi = (uint64_t) (p >> 64);
+    return (uint64_t) p;
+#else
+    const uint64_t a0 = (uint32_t) a, a1 = a >> 32, b0 = (uint32_t) b, b1 = b >> 32;
+    const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const uint64_t mid = (p00 >> 32) + (uint32_t) p10 + (uint32_t) p01;
+    *hi = p11 + (p10 >> 32) + (p01 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t) p00;
+#endif
+}
+
+static inline uint64_t fmt_shr128(const uint64_t lo, const uint64_t hi, const uint32_t n) {
+    return (hi << (64 - n)) | (lo >> n);
+}
+
+// Computes 5^i, or 1/5^i if `inverse` is set, as a 125-bit fixed-point number.
+static void fmt_pow5(const uint32_t i, const bool inverse, uint64_t *res) {
+    const uint32_t base = inverse ? (i + 25) / 26 : i / 26;
+    const uint32_t offset = inverse ? base * 26 - i : i - base * 26;
+    const uint64_t *mul = inverse ? FMT_POW5_INV_SPLIT[base] : FMT_POW5_SPLIT[base];
+    const uint32_t corr = ((inverse ? FMT_POW5_INV_OFFSETS : FMT_POW5_OFFSETS)[i / 16] >> ((i % 16) * 2)) & 3;
+    if (offset == 0) {
+        res[0] = mul[0] + corr;
+        res[1] = mul[1];
+        return;
+    }
+    uint64_t hi0, hi1;
+    const uint64_t lo1 = fmt_umul128(FMT_POW5[offset], mul[1], &hi1);
+    const uint64_t lo0 = fmt_umul128(FMT_POW5[offset], mul[0], &hi0);
+    const uint64_t sum = hi0 + lo1;
+    hi1 += sum < hi0;
+    const int32_t delta = inverse ? fmt_pow5bits((int32_t) (base * 26)) - fmt_pow5bits((int32_t) i)
+                                  : fmt_pow5bits((int32_t) i) - fmt_pow5bits((int32_t) (base * 26));
+    res[0] = fmt_shr128(lo0, sum, (uint32_t) delta) + corr;
+    res[1] = fmt_shr128(sum, hi1, (uint32_t) delta);
+}
+
+static uint64_t fmt_mul_shift(const uint64_t m, const uint64_t *mul, const int32_t j) {
+    uint64_t hi0, hi1;
+    const uint64_t lo1 = fmt_umul128(m, mul[1], &hi1);
+    fmt_umul128(m, mul[0], &hi0);
+    const uint64_t sum = hi0 + lo1;
+    hi1 += sum < hi0;
+    return fmt_shr128(sum, hi1, (uint32_t) (j - 64));
+}
+
+static bool fmt_pow5_multiple(uint64_t x, const uint32_t p) {
+    uint32_t n = 0;
+    while (x % 5 == 0 && n < p) {
+        x /= 5;
+        ++n;
+    }
+    return n >= p;
+}
+
+// Computes the shortest decimal number `x` * 10^`e` that reads back as the positive floating-point number with the
+// given mantissa and biased exponent. Floating-point numbers of single precision are converted using the powers of
+// five of double precision, which are more than precise enough.
+static uint64_t fmt_shortest(const uint64_t mantissa, const uint32_t exponent, const uint32_t bits, const int32_t bias,
+                             int32_t *e) {
+    int32_t e2;
+    uint64_t m2;
+    if (exponent == 0) {
+        e2 = 1 - bias - (int32_t) bits - 2;
+        m2 = mantissa;
+    } else {
+        e2 = (int32_t) exponent - bias - (int32_t) bits - 2;
+        m2 = (UINT64_C(1) << bits) | mantissa;
+    }
+    // The interval of numbers that read back as the floating-point number is (mm, mp) scaled by 4, its bounds are
+    // included if the mantissa is even
+    const bool even = (m2 & 1) == 0;
+    const uint64_t mv = 4 * m2;
+    const uint32_t shift = mantissa != 0 || exponent <= 1;
+    uint64_t vr, vp, vm, pow5[2];
+    int32_t e10;
+    bool vmZeros = false, vrZeros = false;
+    if (e2 >= 0) {
+        const uint32_t q = (uint32_t) ((e2 * 78913) >> 18) - (e2 > 3);
+        e10 = (int32_t) q;
+        const int32_t i = -e2 + (int32_t) q + 125 + fmt_pow5bits((int32_t) q) - 1;
+        fmt_pow5(q, true, pow5);
+        vr = fmt_mul_shift(mv, pow5, i);
+        vp = fmt_mul_shift(mv + 2, pow5, i);
+        vm = fmt_mul_shift(mv - 1 - shift, pow5, i);
+        if (q <= 21) {
+            if (mv % 5 == 0) {
+                vrZeros = fmt_pow5_multiple(mv, q);
+            } else if (even) {
+                vmZeros = fmt_pow5_multiple(mv - 1 - shift, q);
+            } else {
+                vp -= fmt_pow5_multiple(mv + 2, q);
+            }
+        }
+    } else {
+        const uint32_t q = (uint32_t) ((-e2 * 732923) >> 20) - (-e2 > 1);
+        e10 = (int32_t) q + e2;
+        const int32_t i = -e2 - (int32_t) q;
+        const int32_t j = (int32_t) q - (fmt_pow5bits(i) - 125);
+        fmt_pow5((uint32_t) i, false, pow5);
+        vr = fmt_mul_shift(mv, pow5, j);
+        vp = fmt_mul_shift(mv + 2, pow5, j);
+        vm = fmt_mul_shift(mv - 1 - shift, pow5, j);
+        if (q <= 1) {
+            vrZeros = true;
+            if (even) {
+                vmZeros = shift == 1;
+            } else {
+                --vp;
+            }
+        } else if (q < 63) {
+            vrZeros = (mv & ((UINT64_C(1) << q) - 1)) == 0;
+        }
+    }
+    // Remove the digits that are not required to distinguish the number from its neighbours
+    int32_t removed = 0;
+    uint32_t last = 0;
+    uint64_t x;
+    if (vmZeros || vrZeros) {
+        while (vp / 10 > vm / 10) {
+            vmZeros &= vm % 10 == 0;
+            vrZeros &= last == 0;
+            last = (uint32_t) (vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        if (vmZeros) {
+            while (vm % 10 == 0) {
+                vrZeros &= last == 0;
+                last = (uint32_t) (vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+        if (vrZeros && last == 5 && vr % 2 == 0) {
+            // Round half to even
+            last = 4;
+        }
+        x = vr + ((vr == vm && (!even || !vmZeros)) || last >= 5);
+    } else {
+        bool up = false;
+        if (vp / 100 > vm / 100) {
+            up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        x = vr + (vr == vm || up);
+    }
+    while (x % 10 == 0) {
+        x /= 10;
+        ++removed;
+    }
+    *e = e10 + removed;
+    return x;
+}
+
+// Formats the shortest representation of a floating-point number, see `fmt_shortest`, and returns its length. The
+// number is formatted in fixed-point notation if its decimal exponent is at least -4 and less than 16 and in
+// scientific notation otherwise, e.g., `0.001`, `100.0` and `1.5E+16`.
+static size_t fmt_real(char *buf, const uint64_t mantissa, const uint32_t exponent, const uint32_t bits,
+                       const int32_t bias, const bool negative) {
+    char *p = buf;
+    if (negative) {
+        *p++ = '-';
+    }
+    if (exponent == 0 && mantissa == 0) {
+        memcpy(p, "0.0", 3);
+        return (size_t) (p + 3 - buf);
+    }
+    int32_t e;
+    char tmp[20];
+    const size_t n = fmt_uint(tmp + sizeof(tmp), fmt_shortest(mantissa, exponent, bits, bias, &e));
+    const char *d = tmp + sizeof(tmp) - n;
+    // Exponent of the leading digit
+    int32_t x = e + (int32_t) n - 1;
+    if (x >= -4 && x < 16) {
+        if (x < 0) {
+            memcpy(p, "0.0000", (size_t) (1 - x));
+            p += 1 - x;
+            memcpy(p, d, n);
+            p += n;
+        } else if ((size_t) x + 1 >= n) {
+            memcpy(p, d, n);
+            p += n;
+            memset(p, '0', (size_t) x + 1 - n);
+            p += (size_t) x + 1 - n;
+            memcpy(p, ".0", 2);
+            p += 2;
+        } else {
+            memcpy(p, d, (size_t) x + 1);
+            p += x + 1;
+            *p++ = '.';
+            memcpy(p, d + x + 1, n - (size_t) x - 1);
+            p += n - (size_t) x - 1;
+        }
+    } else {
+        *p++ = d[0];
+        *p++ = '.';
+        if (n > 1) {
+            memcpy(p, d + 1, n - 1);
+            p += n - 1;
+        } else {
+            *p++ = '0';
+        }
+        *p++ = 'E';
+        *p++ = x < 0 ? '-' : '+';
+        if (x < 0) {
+            x = -x;
+        }
+        if (x >= 100) {
+            *p++ = (char) ('0' + x / 100);
+            x %= 100;
+        }
+        memcpy(p, FMT_DIGITS + x * 2, 2);
+        p += 2;
+    }
+    return (size_t) (p - buf);
+}
+
+// Parses an integer in decimal or hexadecimal notation with an optional sign. As `strtoll` does, a decimal number out
+// of range is clamped to the range of 64-bit integers. As `strtoull` does, a hexadecimal number out of range is read
+// as the largest unsigned 64-bit integer and a negative number is negated modulo 2^64.
+static bool fmt_parse_int(const char *s, const bool hex, int64_t *val) {
+    while (*s == ' ' || (*s >= '\t' && *s <= '\r')) {
+        ++s;
+    }
+    const bool negative = *s == '-';
+    if (*s == '-' || *s == '+') {
+        ++s;
+    }
+    const uint64_t base = hex ? 16 : 10;
+    // The number overflows if it exceeds `limit` before the last digit or `limit` * `base` + `rest` with it
+    const uint64_t limit = hex ? UINT64_MAX / 16 : UINT64_MAX / 10;
+    const uint64_t rest = hex ? UINT64_MAX % 16 : UINT64_MAX % 10;
+    uint64_t x = 0;
+    bool overflow = false, digits = false;
+    for (;; ++s) {
+        uint64_t d;
+        if (*s >= '0' && *s <= '9') {
+            d = (uint64_t) (*s - '0');
+        } else if (hex && *s >= 'A' && *s <= 'F') {
+            d = (uint64_t) (*s - 'A' + 10);
+        } else if (hex && *s >= 'a' && *s <= 'f') {
+            d = (uint64_t) (*s - 'a' + 10);
+        } else {
+            break;
+        }
+        overflow |= x > limit || (x == limit && d > rest);
+        x = x * base + d;
+        digits = true;
+    }
+    if (hex) {
+        *val = (int64_t) (overflow ? UINT64_MAX : negative ? 0 - x : x);
+    } else if (negative) {
+        *val = overflow || x > (uint64_t) INT64_MAX + 1 ? INT64_MIN : (int64_t) (0 - x);
+    } else {
+        *val = overflow || x > (uint64_t) INT64_MAX ? INT64_MAX : (int64_t) x;
+    }
+    return digits;
+}
+
+// Splits the number in decimal notation `s` into its digits `x` and its exponent `e`. Returns false if the number has
+// more than 19 significant digits or is not a plain decimal number, e.g., `inf`.
+static bool fmt_decimal(const char *s, uint64_t *x, int32_t *e, bool *negative) {
+    *negative = *s == '-';
+    if (*s == '-' || *s == '+') {
+        ++s;
+    }
+    uint64_t m = 0;
+    int32_t n = 0, scale = 0;
+    bool point = false, digits = false;
+    for (;; ++s) {
+        if (*s >= '0' && *s <= '9') {
+            digits = true;
+            if (m != 0 || *s != '0') {
+                if (++n > 19) {
+                    return false;
+                }
+                m = m * 10 + (uint64_t) (*s - '0');
+            }
+            scale -= point;
+        } else if (*s == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+    int32_t exp = 0;
+    if (*s == 'e' || *s == 'E') {
+        ++s;
+        const bool minus = *s == '-';
+        if (*s == '-' || *s == '+') {
+            ++s;
+        }
+        if (*s < '0' || *s > '9') {
+            return false;
+        }
+        for (; *s >= '0' && *s <= '9'; ++s) {
+            if (exp < 100000) {
+                exp = exp * 10 + (*s - '0');
+            }
+        }
+        exp = minus ? -exp : exp;
+    }
+    *x = m;
+    *e = exp + scale;
+    return *s == '\0';
+}
+
+// Converts a number in decimal notation to the nearest double. If the digits and the power of ten are both exact
+// in double precision, a single multiplication or division rounds correctly, otherwise `strtod` is used.
+static double fmt_parse_double(const char *s) {
+    uint64_t x;
+    int32_t e;
+    bool negative;
+    if (fmt_decimal(s, &x, &e, &negative) && x <= UINT64_C(1) << 53 && e >= -22 && e <= 22) {
+        const double d = e < 0 ? (double) x / FMT_TEN[-e] : (double) x * FMT_TEN[e];
+        return negative ? -d : d;
+    }
+    return strtod(s, NULL);
+}
+
+// Converts a number in decimal notation to the nearest float, see `fmt_parse_double`.
+static float fmt_parse_float(const char *s) {
+    uint64_t x;
+    int32_t e;
+    bool negative;
+    if (fmt_decimal(s, &x, &e, &negative) && x <= UINT64_C(1) << 24 && e >= -10 && e <= 10) {
+        const float f = e < 0 ? (float) x / (float) FMT_TEN[-e] : (float) x * (float) FMT_TEN[e];
+        return negative ? -f : f;
+    }
+    return strtof(s, NULL);
+}
+
+// Input buffer of module `In`, which reads the standard input stream in blocks and scans the tokens directly from the
+// buffer. As reading the next block waits for input if the stream is interactive, the output of interactive writers is
+// written before, see module `Texts`.
+#define IN_BUF_SIZE ((size_t) 65536)
+// Maximum length of a real number read by module `In`.
+#define IN_REAL_SIZE ((size_t) 512)
+
+static char in_buf[IN_BUF_SIZE];
+static size_t in_pos = 0, in_len = 0;
+static bool in_eof = false;
+
+// Writes the output of interactive writers before reading the input, see module `Texts`.
+static void texts_sync(void);
+
+// Reads the next block of the standard input stream into the buffer. Returns false at the end of the stream.
+static bool in_fill(void) {
+    if (in_eof) {
+        return false;
+    }
+    texts_sync();
+#if defined(_WIN32) || defined(_WIN64)
+    const int n = _read(0, in_buf, (unsigned) IN_BUF_SIZE);
+#else
+    ssize_t n;
+    do {
+        n = read(STDIN_FILENO, in_buf, IN_BUF_SIZE);
+    } while (n < 0 && errno == EINTR);
+#endif
+    if (n <= 0) {
+        in_eof = true;
+        return false;
+    }
+    in_pos = 0;
+    in_len = (size_t) n;
+    return true;
+}
+
+// Returns the next character of the input, or `EOF` at the end of the input.
+static inline int in_next(void) {
+    if (in_pos == in_len && !in_fill()) {
+        return EOF;
+    }
+    return (unsigned char) in_buf[in_pos++];
+}
+
+// Pushes back the character that was returned by the last call of `in_next`, unless it was `EOF`.
+static inline void in_back(const int ch) {
+    if (ch != EOF) {
+        --in_pos;
+    }
+}
+
+// Skips white space and returns the first character that follows.
+static inline int in_skip(void) {
+    int ch;
+    do {
+        ch = in_next();
+    } while (ch == ' ' || (ch >= '\t' && ch <= '\r'));
+    return ch;
+}
+
 bool olang_in_getchar(char *ch) {
-    const int n = getchar();
+    const int n = in_next();
     *ch = (char) n;
     return n != EOF;
 }
 
-bool olang_in_ungetchar(const char ch) {
-    return ungetc(ch, stdin) == ch;
+// Reads an integer in decimal or hexadecimal notation, e.g., `-123` or `0FFH`, into the buffer and sets `hex` if it
+// has the suffix `H`. Leading white space is skipped. Fails if the integer does not fit into the buffer or is not
+// followed by another character.
+static bool in_scan_int(char *buf, const size_t size, bool *hex) {
+    size_t n = 0;
+    int ch = in_skip();
+    if (ch == '-') {
+        buf[n++] = (char) ch;
+        ch = in_next();
+    }
+    if (ch < '0' || ch > '9') {
+        return false;
+    }
+    while (n < size && ((ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'F') || (ch >= 'a' && ch <= 'f'))) {
+        buf[n++] = (char) ch;
+        ch = in_next();
+    }
+    if (n == size || ch == EOF) {
+        return false;
+    }
+    buf[n] = '\0';
+    *hex = ch == 'H' || ch == 'h';
+    if (!*hex) {
+        in_back(ch);
+    }
+    return true;
+}
+
+// Reads a number in decimal notation into the buffer, as `scanf` does for `%f`. Leading white space is skipped and
+// the first character that does not belong to the number is pushed back.
+static bool in_scan_real(char *buf, const size_t size) {
+    size_t n = 0;
+    int ch = in_skip();
+    if (ch == '-' || ch == '+') {
+        buf[n++] = (char) ch;
+        ch = in_next();
+    }
+    if (ch == 'i' || ch == 'I' || ch == 'n' || ch == 'N') {
+        // Infinity or not-a-number
+        while (n < size - 1 && ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'))) {
+            buf[n++] = (char) ch;
+            ch = in_next();
+        }
+        in_back(ch);
+        buf[n] = '\0';
+        char *end;
+        strtod(buf, &end);
+        return *end == '\0' && end != buf;
+    }
+    size_t digits = 0;
+    while (n < size - 1 && ch >= '0' && ch <= '9') {
+        buf[n++] = (char) ch;
+        ch = in_next();
+        ++digits;
+    }
+    if (n < size - 1 && ch == '.') {
+        buf[n++] = (char) ch;
+        ch = in_next();
+        while (n < size - 1 && ch >= '0' && ch <= '9') {
+            buf[n++] = (char) ch;
+            ch = in_next();
+            ++digits;
+        }
+    }
+    if (digits > 0 && n < size - 1 && (ch == 'e' || ch == 'E')) {
+        buf[n++] = (char) ch;
+        ch = in_next();
+        if (n < size - 1 && (ch == '-' || ch == '+')) {
+            buf[n++] = (char) ch;
+            ch = in_next();
+        }
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
+        while (n < size - 1 && ch >= '0' && ch <= '9') {
+            buf[n++] = (char) ch;
+            ch = in_next();
+        }
+    }
+    in_back(ch);
+    buf[n] = '\0';
+    return digits > 0 && n < size - 1;
+}
+
+bool olang_in_getint(int32_t *val) {
+    char buf[12];
+    bool hex;
+    int64_t x;
+    if (in_scan_int(buf, sizeof(buf), &hex) && fmt_parse_int(buf, hex, &x)) {
+        *val = (int32_t) x;
+        return true;
+    }
+    return false;
+}
+
+bool olang_in_getlong(int64_t *val) {
+    char buf[21];
+    bool hex;
+    return in_scan_int(buf, sizeof(buf), &hex) && fmt_parse_int(buf, hex, val);
 }
 
 bool olang_in_getfloat(float *f) {
-    return scanf("%f", f) == 1;
+    char buf[IN_REAL_SIZE];
+    if (in_scan_real(buf, sizeof(buf))) {
+        *f = fmt_parse_float(buf);
+        return true;
+    }
+    return false;
 }
 
 bool olang_in_getdouble(double *d) {
-    return scanf("%lf", d) == 1;
+    char buf[IN_REAL_SIZE];
+    if (in_scan_real(buf, sizeof(buf))) {
+        *d = fmt_parse_double(buf);
+        return true;
+    }
+    return false;
 }
 
-bool olang_in_getint(const char *buf, int32_t *val, bool hex) {
-    if (hex) {
-        return sscanf(buf, "%" SCNx32, (uint32_t *) val) == 1;
+bool olang_in_getstring(char *str, const int64_t len) {
+    if (in_skip() != '"') {
+        return false;
+    }
+    int64_t i = 0;
+    int ch = in_next();
+    while (i < len && ch >= ' ' && ch != '"') {
+        str[i++] = (char) ch;
+        ch = in_next();
+    }
+    if (i == len || ch != '"') {
+        return false;
     }
-    return sscanf(buf, "%" SCNd32, val) == 1;
+    str[i] = '\0';
+    return true;
 }
 
-bool olang_in_getlong(const char *buf, int64_t *val, bool hex) {
-    if (hex) {
-        return sscanf(buf, "%" SCNx64, (uint64_t *) val) == 1;
+bool olang_in_getname(char *name, const int64_t len) {
+    int ch = in_skip();
+    if (ch == EOF) {
+        return false;
+    }
+    int64_t i = 0;
+    while (i < len && ((ch > ' ' && ch < 0x7F) || ch >= 0x80)) {
+        name[i++] = (char) ch;
+        ch = in_next();
     }
-    return sscanf(buf, "%" SCNd64, val) == 1;
+    if (i == len) {
+        return false;
+    }
+    name[i] = '\0';
+    return ch != EOF;
+}
+
+bool olang_in_getline(char *line, const int64_t len) {
+    int64_t i = 0;
+    int ch = in_next();
+    while (ch != EOF && ch != '\n') {
+        if (i < len) {
+            line[i] = (char) ch;
+        }
+        ++i;
+        ch = in_next();
+    }
+    if (i == 0 || ch != '\n') {
+        return false;
+    }
+    if (i < len) {
+        line[i] = '\0';
+        return true;
+    }
+    line[len - 1] = '\0';
+    return false;
 }
 
 float olang_math_realf(const int32_t x) {
@@ -165,3 +1338,233 @@ double olang_reals_nanL(void) {
     const union ieee754_double d = { .ieee.exponent = 2047, .ieee.mantissa0 = 0xfffff, .ieee.mantissa1 = 0xffffffff };
     return d.d;
 }
+
+// Returns the least significant decimal digit of `x` and divides `x` by ten, as `MOD` and `DIV` do.
+static char reals_digit(int64_t *x) {
+    int64_t q = *x / 10, r = *x % 10;
+    if (r < 0) {
+        r += 10;
+        --q;
+    }
+    *x = q;
+    return (char) ('0' + r);
+}
+
+void olang_reals_convert(int64_t x, const int32_t n, char *d) {
+    int32_t i = 0;
+    for (; x >= 0 && i + 1 < n; i += 2) {
+        const size_t r = (size_t) (x % 100) * 2;
+        d[i] = FMT_DIGITS[r + 1];
+        d[i + 1] = FMT_DIGITS[r];
+        x /= 100;
+    }
+    for (; i < n; ++i) {
+        d[i] = reals_digit(&x);
+    }
+}
+
+void olang_reals_digits(int64_t x, const int32_t n, char *d) {
+    int32_t i = n;
+    for (; x >= 0 && i > 1; i -= 2) {
+        memcpy(d + i - 2, FMT_DIGITS + (x % 100) * 2, 2);
+        x /= 100;
+    }
+    for (; i > 0; --i) {
+        d[i - 1] = reals_digit(&x);
+    }
+}
+
+// Output buffer of the writers of module `Texts`, which is shared by all writers as they all write to the standard
+// output stream. The buffer is written to the stream when it is full or flushed, when the program exits, or when the
+// program traps. If the stream is interactive, the buffer is also written at the end of every line and before input is
+// read from the standard input stream.
+#define TEXTS_BUFFER_SIZE ((size_t) 8192)
+
+static char texts_buf[TEXTS_BUFFER_SIZE];
+static size_t texts_len = 0;
+static bool texts_line = false;
+static bool texts_initialized = false;
+
+static void texts_write(const bool sync) {
+    if (texts_len > 0) {
+        fwrite(texts_buf, 1, texts_len, stdout);
+        texts_len = 0;
+    }
+    if (sync) {
+        fflush(stdout);
+    }
+}
+
+static void texts_exit(void) {
+    texts_write(false);
+}
+
+static void texts_sync(void) {
+    if (texts_line) {
+        texts_write(true);
+    }
+}
+
+// Writes the buffer before a trap terminates the program and passes the trap on to the handler that was installed
+// before, e.g., the handler of the JIT that reports the trap.
+#if defined(_WIN32) || defined(_WIN64)
+static LONG WINAPI texts_trap(EXCEPTION_POINTERS *info) {
+    const DWORD code = info->ExceptionRecord->ExceptionCode;
+    if (code == EXCEPTION_ILLEGAL_INSTRUCTION || code == EXCEPTION_BREAKPOINT) {
+        texts_write(true);
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+#else
+static struct sigaction texts_sigill, texts_sigtrap;
+
+static void texts_trap(const int sig, siginfo_t *info, void *context) {
+    texts_write(true);
+    const struct sigaction *prev = sig == SIGILL ? &texts_sigill : &texts_sigtrap;
+    if ((prev->sa_flags & SA_SIGINFO) != 0) {
+        prev->sa_sigaction(sig, info, context);
+    } else if (prev->sa_handler != SIG_DFL && prev->sa_handler != SIG_IGN) {
+        prev->sa_handler(sig);
+    } else {
+        sigaction(sig, prev, NULL);
+        raise(sig);
+    }
+}
+#endif
+
+static void texts_init(void) {
+#if defined(_WIN32) || defined(_WIN64)
+    texts_line = _isatty(_fileno(stdout));
+    AddVectoredExceptionHandler(1, texts_trap);
+#else
+    texts_line = isatty(fileno(stdout));
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = texts_trap;
+    sa.sa_flags = SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGILL, &sa, &texts_sigill);
+    sigaction(SIGTRAP, &sa, &texts_sigtrap);
+#endif
+    atexit(texts_exit);
+    texts_initialized = true;
+}
+
+static void texts_put(const char *s, const size_t n) {
+    if (texts_len + n > TEXTS_BUFFER_SIZE) {
+        texts_write(false);
+    }
+    if (n >= TEXTS_BUFFER_SIZE) {
+        fwrite(s, 1, n, stdout);
+    } else {
+        memcpy(texts_buf + texts_len, s, n);
+        texts_len += n;
+    }
+}
+
+// Writes `n` blanks, if `n` is positive.
+static void texts_fill(int64_t n) {
+    while (n > 0) {
+        if (texts_len == TEXTS_BUFFER_SIZE) {
+            texts_write(false);
+        }
+        const size_t k = (uint64_t) n < TEXTS_BUFFER_SIZE - texts_len ? (size_t) n : TEXTS_BUFFER_SIZE - texts_len;
+        memset(texts_buf + texts_len, ' ', k);
+        texts_len += k;
+        n -= (int64_t) k;
+    }
+}
+
+void olang_texts_write(const char ch) {
+    if (!texts_initialized) {
+        texts_init();
+    }
+    if (texts_len == TEXTS_BUFFER_SIZE) {
+        texts_write(false);
+    }
+    texts_buf[texts_len++] = ch;
+    if (ch == '\n' && texts_line) {
+        texts_write(true);
+    }
+}
+
+void olang_texts_write_string(const char *s, const int64_t len) {
+    if (!texts_initialized) {
+        texts_init();
+    }
+    const char *end = memchr(s, '\0', (size_t) len);
+    const size_t n = end == NULL ? (size_t) len : (size_t) (end - s);
+    texts_put(s, n);
+    if (texts_line && memchr(s, '\n', n) != NULL) {
+        texts_write(true);
+    }
+}
+
+void olang_texts_write_int(const int64_t x, const int64_t n) {
+    if (!texts_initialized) {
+        texts_init();
+    }
+    char buf[20];
+    size_t len = fmt_uint(buf + sizeof(buf), x < 0 ? 0 - (uint64_t) x : (uint64_t) x);
+    if (x < 0) {
+        buf[sizeof(buf) - ++len] = '-';
+    }
+    texts_fill(n - (int64_t) len);
+    texts_put(buf + sizeof(buf) - len, len);
+}
+
+void olang_texts_write_hex(uint64_t x, const int32_t n) {
+    if (!texts_initialized) {
+        texts_init();
+    }
+    static const char digits[] = "0123456789ABCDEF";
+    char buf[16];
+    const size_t len = n < 0 ? 0 : n > 16 ? 16 : (size_t) n;
+    for (size_t i = len; i > 0; --i) {
+        buf[i - 1] = digits[x & 15];
+        x >>= 4;
+    }
+    texts_put(buf, len);
+}
+
+// Writes the shortest representation of a floating-point number, see `fmt_real`, in `n` field positions.
+static void texts_write_real(const uint64_t mantissa, const uint32_t exponent, const uint32_t bits, const int32_t bias,
+                             const bool negative, const int32_t n) {
+    if (!texts_initialized) {
+        texts_init();
+    }
+    char buf[32];
+    size_t len;
+    // The largest exponent, i.e., 2 * bias + 1, denotes infinity and not-a-number
+    if (exponent == (uint32_t) bias * 2 + 1) {
+        const char *s = mantissa != 0 ? "NaN" : negative ? "-INF" : "INF";
+        len = strlen(s);
+        memcpy(buf, s, len);
+    } else {
+        len = fmt_real(buf, mantissa, exponent, bits, bias, negative);
+    }
+    texts_fill(n - (int64_t) len);
+    texts_put(buf, len);
+}
+
+void olang_texts_write_real(const float x, const int32_t n) {
+    const union ieee754_float f = { .f = x };
+    texts_write_real(f.ieee.mantissa, f.ieee.exponent, 23, 127, f.ieee.negative, n);
+}
+
+void olang_texts_write_realL(const double x, const int32_t n) {
+    const union ieee754_double d = { .d = x };
+    texts_write_real((uint64_t) d.ieee.mantissa0 << 32 | d.ieee.mantissa1, d.ieee.exponent, 52, 1023,
+                     d.ieee.negative, n);
+}
+
+void olang_texts_flush(void) {
+    texts_write(true);
+}
+
+void olang_texts_set_line(const bool line) {
+    if (!texts_initialized) {
+        texts_init();
+    }
+    texts_line = line;
+}
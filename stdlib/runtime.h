@@ -11,20 +11,52 @@
 #include <stdio.h>
 #include <time.h>
 
+// Memory management
+void *olang_rt_alloc(int64_t);
+void olang_rt_free(void *);
+
+// String comparison
+int32_t olang_rt_strcmp_n(const char *, int64_t, const char *, int64_t);
+
+// Garbage collection
+typedef struct {
+    int64_t collections;
+    int64_t allocated;
+    int64_t freed;
+    int64_t heap;
+    int64_t objects;
+    int64_t time;
+} olang_gc_statistics;
+
+void olang_gc_register(void *, const void *, int64_t);
+void *olang_gc_alloc(int64_t, const void *);
+void olang_gc_free(void *);
+void olang_gc_collect(void);
+void olang_gc_stats(olang_gc_statistics *);
+
 // Module `Files`
 bool olang_files_fexists(const char *);
 void olang_files_fregister(FILE *, const char *);
 int64_t olang_files_flength(FILE *);
 bool olang_files_fseek(FILE*, int64_t);
+int64_t olang_files_fread(FILE *, int64_t, uint8_t *, int64_t, int64_t);
+bool olang_files_fwrite(FILE *, int64_t, const uint8_t *, int64_t, int64_t);
+void olang_files_copy(uint8_t *, int64_t, const uint8_t *, int64_t, int64_t);
+int64_t olang_files_mmap(const char *, int64_t *);
+void olang_files_munmap(int64_t, int64_t);
+void olang_files_mcopy(uint8_t *, int64_t, int64_t, int64_t);
 void olang_files_fdate(const char *, int64_t *, int64_t *);
+void olang_files_atexit(void (*)(void));
 
 // Module `In`
 bool olang_in_getchar(char *);
-bool olang_in_ungetchar(char);
+bool olang_in_getint(int32_t *);
+bool olang_in_getlong(int64_t *);
 bool olang_in_getfloat(float *);
 bool olang_in_getdouble(double *);
-bool olang_in_getint(const char *, int32_t *, bool);
-bool olang_in_getlong(const char *, int64_t *, bool);
+bool olang_in_getstring(char *, int64_t);
+bool olang_in_getname(char *, int64_t);
+bool olang_in_getline(char *, int64_t);
 
 // Module `Math`
 float olang_math_realf(int32_t);
@@ -46,6 +78,18 @@ int32_t olang_reals_nan_code(float);
 void olang_reals_nan_codeL(double, int32_t *, int32_t *);
 float olang_reals_nan(void);
 double olang_reals_nanL(void);
+void olang_reals_convert(int64_t, int32_t, char *);
+void olang_reals_digits(int64_t, int32_t, char *);
+
+// Module `Texts`
+void olang_texts_write(char);
+void olang_texts_write_string(const char *, int64_t);
+void olang_texts_write_int(int64_t, int64_t);
+void olang_texts_write_hex(uint64_t, int32_t);
+void olang_texts_write_real(float, int32_t);
+void olang_texts_write_realL(double, int32_t);
+void olang_texts_flush(void);
+void olang_texts_set_line(bool);
 
 
 #endif //_STDLIB_RUNTIME_H
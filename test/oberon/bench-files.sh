@@ -0,0 +1,9 @@
+#!/bin/sh
+# Files benchmark: throughput of Riders that read and write a temporary file byte by byte and in blocks.
+#
+# Usage: bench-files.sh [compiler] [level]
+
+. ./bench.sh
+
+echo "Riders on a temporary file (-$LEVEL):"
+run FilesRider -$LEVEL
@@ -0,0 +1,19 @@
+#!/bin/sh
+# In benchmark: throughput of module In reading 10 million integers from the standard input stream in blocks compared
+# to module In as it was before, which read them one character at a time through the C library, see InBaseline.Mod.
+#
+# Usage: bench-in.sh [compiler] [level]
+
+. ./bench.sh
+clean InRead.txt InBaseline.o InBaseline.smb libin-baseline.so
+
+awk 'BEGIN { srand(1); for (i = 0; i < 10000000; i++) print int(rand() * 4294967296) - 2147483648 }' > InRead.txt
+
+${CC:-cc} -O2 -shared -fPIC -o libin-baseline.so in-baseline.c || exit 1
+$O7C -$LEVEL -fenable-extern -I$INC -c InBaseline.Mod || exit 1
+
+echo "Integers read one character at a time by the previous module In (-$LEVEL):"
+run InReadBaseline -$LEVEL -lin-baseline < InRead.txt
+
+echo "Integers read in blocks by module In (-$LEVEL):"
+run InRead -$LEVEL < InRead.txt
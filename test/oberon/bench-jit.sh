@@ -0,0 +1,25 @@
+#!/bin/sh
+# JIT benchmark: time to the first output and throughput of a hot procedure, with all procedures optimized before the
+# program is started compared to procedures that are compiled on first call and optimized once they are hot.
+#
+# Usage: bench-jit.sh [compiler] [level]
+
+. ./bench.sh
+# The module is run in a pipeline, whose clean-up registrations are lost.
+clean TieredJit.smb
+
+# Prints the time until the first line of output, followed by the output of the program.
+first() {
+    start=$(date +%s%N)
+    "$@" | {
+        read -r line
+        echo "First output after $(( ($(date +%s%N) - start) / 1000000 )) ms: $line"
+        cat
+    }
+}
+
+echo "Optimized before the program is started (-$LEVEL):"
+first run TieredJit -$LEVEL || exit 1
+
+echo "Compiled on first call, optimized once hot (-fjit=tiered):"
+first run TieredJit -fjit=tiered || exit 1
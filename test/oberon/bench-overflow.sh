@@ -0,0 +1,17 @@
+#!/bin/sh
+# Overflow check benchmark: integer reduction loops with overflow checks that trap immediately compared to overflow
+# checks that are combined into a flag, which is checked once the loop is exited.
+#
+# Usage: bench-overflow.sh [compiler] [level]
+
+LEVEL=${2:-O3}
+. ./bench.sh
+
+echo "Overflow checks trap immediately (-$LEVEL):"
+run OverflowLoop -$LEVEL
+
+echo "Overflow checks are deferred to loop exit (-$LEVEL -fdefer-overflow-trap):"
+run OverflowLoop -$LEVEL -fdefer-overflow-trap
+
+echo "Overflow checks are disabled (-$LEVEL -fno-sanitize=signed-integer-overflow):"
+run OverflowLoop -$LEVEL -fno-sanitize=signed-integer-overflow
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Start-up benchmark: compiling and running a small module is dominated by the start-up time of the compiler, which is
+# compared to the start-up time of a baseline compiler built from the revision before only the native or requested
+# target was initialized, e.g., in a worktree created with `git worktree add`.
+#
+# Usage: bench-startup.sh [compiler] [baseline compiler] [runs]
+
+. ./bench.sh
+BASE=${2:-./oberon-lang-baseline}
+RUNS=${3:-50}
+
+if [ ! -x "$BASE" ]; then
+    echo "Baseline compiler '$BASE' not found." >&2
+    exit 1
+fi
+clean HelloWorld.o HelloWorld.smb
+
+# Prints the time of running a compiler the given number of times: repeat <compiler> <argument>...
+repeat() {
+    compiler=$1
+    shift
+    time -p sh -c "for i in \$(seq $RUNS); do $compiler $* > /dev/null || exit 1; done" || exit 1
+}
+
+for compiler in "$BASE" "$O7C"; do
+    echo "Compiling HelloWorld.Mod $RUNS times with $compiler:"
+    repeat "$compiler" -c -I$INC HelloWorld.Mod
+
+    echo "Cross-compiling HelloWorld.Mod for aarch64 $RUNS times with $compiler:"
+    repeat "$compiler" -c -I$INC --target aarch64-linux-gnu HelloWorld.Mod
+
+    echo "Running HelloWorld.Mod $RUNS times with $compiler:"
+    repeat "$compiler" -I$INC -L$LIB -loberon --run HelloWorld.Mod
+done
@@ -0,0 +1,10 @@
+#!/bin/sh
+# Type test benchmark: type tests and type case statements against extension levels whose type ids are stored in the
+# display of the type descriptor compared to a deeper extension level that is looked up in the type ids of all levels.
+#
+# Usage: bench-typetest.sh [compiler] [level]
+
+. ./bench.sh
+
+echo "Type tests (-$LEVEL):"
+run TypeTest -$LEVEL
@@ -0,0 +1,24 @@
+# Shared setup of the benchmark scripts bench-*.sh, which source this file and are run from this directory. The first
+# argument of a benchmark script is the compiler and the second one the optimization level, unless the script says
+# otherwise. The files registered with `clean` are removed when the script exits.
+
+O7C=${1:-./oberon-lang}
+LEVEL=${2:-${LEVEL:-O2}}
+INC=.:./include
+LIB=./lib
+CLEAN=
+
+trap 'rm -f $CLEAN' EXIT
+
+# Registers files that are removed when the script exits: clean <file>...
+clean() {
+    CLEAN="$CLEAN $*"
+}
+
+# Runs a module with the JIT, the remaining arguments are passed to the compiler: run <module> [<option>...]
+run() {
+    module=$1
+    shift
+    clean "$module.smb"
+    $O7C "$@" -I$INC -L$LIB -loberon --run "$module.Mod" || exit 1
+}
@@ -0,0 +1,40 @@
+//
+// Functions of the runtime library used by module In before it read the standard input stream in blocks, which are
+// the baseline of the throughput of module In together with InBaseline.Mod, see bench-in.sh.
+//
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+bool baseline_in_getchar(char *ch) {
+    const int n = getchar();
+    *ch = (char) n;
+    return n != EOF;
+}
+
+bool baseline_in_ungetchar(const char ch) {
+    return ungetc(ch, stdin) == ch;
+}
+
+bool baseline_in_getfloat(float *f) {
+    return scanf("%f", f) == 1;
+}
+
+bool baseline_in_getdouble(double *d) {
+    return scanf("%lf", d) == 1;
+}
+
+bool baseline_in_getint(const char *buf, int32_t *val, bool hex) {
+    if (hex) {
+        return sscanf(buf, "%" SCNx32, (uint32_t *) val) == 1;
+    }
+    return sscanf(buf, "%" SCNd32, val) == 1;
+}
+
+bool baseline_in_getlong(const char *buf, int64_t *val, bool hex) {
+    if (hex) {
+        return sscanf(buf, "%" SCNx64, (uint64_t *) val) == 1;
+    }
+    return sscanf(buf, "%" SCNd64, val) == 1;
+}
@@ -1,10 +1,13 @@
 @echo off
 
+rem The benchmarks of module In read the standard input stream, see bench-in.sh
 for %%f in (*.Mod) do (
-    rem ..\..\build\src\oberon-lang.exe -I.:./include -L.:./lib -loberon -r %%f
-    ..\..\build\olang\Release\oberon-lang.exe -I.;./include -L.;./lib -loberon -r %%f
-    if %errorlevel% neq 0 (
-        echo %%f: error: finished with exit code %errorlevel%. >&2
+    echo %%~nf| findstr /x /i "InRead InReadBaseline InBaseline" >nul || (
+        rem ..\..\build\src\oberon-lang.exe -I.:./include -L.:./lib -loberon -r %%f
+        ..\..\build\olang\Release\oberon-lang.exe -I.;./include -L.;./lib -loberon -r %%f
+        if %errorlevel% neq 0 (
+            echo %%f: error: finished with exit code %errorlevel%. >&2
+        )
     )
 )
 
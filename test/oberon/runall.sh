@@ -1,6 +1,10 @@
 #!/bin/zsh
 
 for file in *.Mod; do
+  # The benchmarks of module In read the standard input stream, see bench-in.sh
+  case "$file" in
+    InRead.Mod|InReadBaseline.Mod|InBaseline.Mod) continue ;;
+  esac
   ./oberon-lang -I.:./include -L.:./lib -loberon -c "$file"
   ./oberon-lang -I.:./include -L.:./lib -loberon -r "$file"
   code=$?
@@ -7,6 +7,9 @@ config.test_source_root = os.path.dirname(__file__)
 config.test_exec_root = os.path.join(os.path.dirname(__file__), "tmp")
 inc = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "oberon", "include"))
 lib = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "oberon", "lib"))
+lto = os.path.join(lib, "lto")
 config.substitutions.append((r"%inc", inc))
 config.substitutions.append((r"%lib", lib))
-config.substitutions.append((r"%oberon", r"oberon-lang"))
\ No newline at end of file
+config.substitutions.append((r"%lto", lto))
+config.substitutions.append((r"%oberon", r"oberon-lang"))
+config.substitutions.append((r"%llvm-ar", r"llvm-ar"))